@@ -0,0 +1,13 @@
+// Per-frame data shared by every program, laid out like FrameData in
+// FrameUniformBuffer.h. ShaderLoader inserts this after the #version line of
+// every stage, so all stages declare the block identically.
+layout (std140) uniform FrameData
+{
+	mat4 vp;
+	vec4 cameraPos;
+	vec4 lightPos;
+	vec4 lightColor;
+	vec4 clusterParams;	// x, y = tile size in pixels, z, w = slice scale and bias
+	vec4 depthParams;	// x = near plane, y = far plane
+	uvec4 clusterGrid;	// clusters along x, y and z
+};
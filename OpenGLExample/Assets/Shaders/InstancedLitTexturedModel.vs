@@ -0,0 +1,47 @@
+#version 450 core
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 texCoord;
+layout (location = 2) in vec2 normal;	// octahedral
+
+// per instance
+layout (location = 4) in uint transformIndex;
+layout (location = 8) in vec2 material;
+
+out vec2 TexCoord;
+out vec3 Normal;
+out vec3 fragWorldPos;
+out vec2 Material;
+
+// per object, written once per frame by the CPU
+layout (std430) readonly buffer ModelData
+{
+	mat4 models[];
+};
+
+layout (std430) readonly buffer NormalData
+{
+	mat3 normalMatrices[];
+};
+
+// Unfolds the square the normal was packed into back onto the sphere
+vec3 decodeOctahedral(vec2 e){
+
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+
+	return normalize(n);
+}
+
+void main(){
+
+	vec4 worldPos = models[transformIndex] * vec4(position, 1.0);
+
+	gl_Position = vp * worldPos;
+	
+	TexCoord = texCoord;
+	Normal = normalMatrices[transformIndex] * decodeOctahedral(normal);
+	fragWorldPos = worldPos.xyz;
+	Material = material;
+}
\ No newline at end of file
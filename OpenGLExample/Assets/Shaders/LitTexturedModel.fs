@@ -3,19 +3,51 @@
 in vec2 TexCoord;
 in vec3 Normal;
 in vec3 fragWorldPos;
+in vec2 Material;	// x = specular strength, y = ambient strength
 
-uniform vec3 cameraPos;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
+// Point lights and the per-cluster lists the CPU builds each frame
+struct PointLight
+{
+	vec4 positionRadius;
+	vec4 color;
+};
 
-uniform float specularStrength;
-uniform float ambientStrength;
+layout (std430) readonly buffer LightData
+{
+	PointLight lights[];
+};
+
+layout (std430) readonly buffer ClusterData
+{
+	uvec2 clusters[];	// x = first entry in lightIndices, y = count
+};
+
+layout (std430) readonly buffer LightIndexData
+{
+	uint lightIndices[];
+};
 
 // texture
 uniform sampler2D Texture;
 
 out vec4 color;
 
+// Must match ClusteredLighting's binning
+uint getCluster(){
+
+	// Window depth back to view space depth
+	float ndcDepth = gl_FragCoord.z * 2.0 - 1.0;
+	float depth = 2.0 * depthParams.x * depthParams.y /
+		(depthParams.y + depthParams.x - ndcDepth * (depthParams.y - depthParams.x));
+
+	uvec3 cluster;
+	cluster.xy = uvec2(gl_FragCoord.xy / clusterParams.xy);
+	cluster.z = uint(max(log(depth) * clusterParams.z - clusterParams.w, 0.0));
+	cluster = min(cluster, clusterGrid.xyz - 1u);
+
+	return cluster.x + clusterGrid.x * (cluster.y + clusterGrid.y * cluster.z);
+}
+
 void main(){
 		
 		//color = texture(Texture, TexCoord);
@@ -24,22 +56,38 @@ void main(){
 		vec4 objColor = texture(Texture, TexCoord);
 
 		//**ambient
-		vec3 ambient = ambientStrength * lightColor;
+		vec3 ambient = Material.y * lightColor.rgb;
 		
 		//**diffuse
-		vec3 lightDir = normalize(lightPos - fragWorldPos);
+		vec3 lightDir = normalize(lightPos.xyz - fragWorldPos);
 		float diff = max(dot(norm, lightDir), 0.0);
-		vec3 diffuse = diff * lightColor;
+		vec3 diffuse = diff * lightColor.rgb;
 		
 		//**specular 
-		vec3 viewDir = normalize(cameraPos - fragWorldPos);
+		vec3 viewDir = normalize(cameraPos.xyz - fragWorldPos);
 		vec3 reflectionDir = reflect(-lightDir, norm);
 		float spec = pow(max(dot(viewDir, reflectionDir),0.0),128);
-		vec3 specular = specularStrength * spec * lightColor;
+		vec3 specular = Material.x * spec * lightColor.rgb;
 		
 		// lighting calculation
 		
 
+		//**point lights in this fragment's cluster, smooth falloff to zero
+		//  at their range
+		uvec2 cluster = clusters[getCluster()];
+
+		for (uint i = 0; i < cluster.y; i++){
+
+			PointLight light = lights[lightIndices[cluster.x + i]];
+
+			vec3 toLight = light.positionRadius.xyz - fragWorldPos;
+			float lightDistance = max(length(toLight), 0.0001);
+			float falloff = clamp(1.0 - lightDistance / light.positionRadius.w, 0.0, 1.0);
+
+			diffuse += max(dot(norm, toLight / lightDistance), 0.0) * falloff * falloff *
+				light.color.rgb;
+		}
+
 		vec3 totalColor = (ambient + diffuse) * objColor.rgb;
 
 		color = vec4(totalColor, 1.0f);
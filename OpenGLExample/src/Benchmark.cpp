@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+
+// std
+#include <algorithm>
+#include <fstream>
+
+void Benchmark::setParameter(const std::string& name, int value)
+{
+	parameters.push_back(std::make_pair(name, std::to_string(value)));
+}
+
+void Benchmark::setParameter(const std::string& name, const std::string& value)
+{
+	// Driver strings may carry anything
+	std::string quoted = "\"";
+
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+		{
+			quoted += '\\';
+		}
+
+		quoted += c;
+	}
+
+	parameters.push_back(std::make_pair(name, quoted + "\""));
+}
+
+void Benchmark::addSample(BenchmarkSeries series, float value)
+{
+	samples[series].push_back(value);
+}
+
+bool Benchmark::write(const std::string& filename)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << "{\n";
+	file << "\t\"parameters\": {";
+
+	for (size_t i = 0; i < parameters.size(); i++)
+	{
+		file << (i == 0 ? "\n" : ",\n") << "\t\t\"" << parameters[i].first <<
+			"\": " << parameters[i].second;
+	}
+
+	file << "\n\t}";
+
+	for (int series = 0; series < kSeriesCount; series++)
+	{
+		std::vector<float> sorted = samples[series];
+		std::sort(sorted.begin(), sorted.end());
+
+		file << ",\n\t\"" << getSeriesName((BenchmarkSeries)series) << "\": {";
+
+		if (sorted.empty())
+		{
+			file << "\"count\": 0}";
+			continue;
+		}
+
+		double total = 0.0;
+
+		for (float sample : sorted)
+		{
+			total += sample;
+		}
+
+		// Nearest rank
+		auto percentile = [&sorted](int p)
+		{
+			return sorted[(sorted.size() - 1) * p / 100];
+		};
+
+		file << "\"count\": " << sorted.size() <<
+			", \"min\": " << sorted.front() <<
+			", \"mean\": " << total / sorted.size() <<
+			", \"p50\": " << percentile(50) <<
+			", \"p90\": " << percentile(90) <<
+			", \"p99\": " << percentile(99) <<
+			", \"max\": " << sorted.back() << "}";
+	}
+
+	file << "\n}\n";
+
+	return true;
+}
+
+const char* Benchmark::getSeriesName(BenchmarkSeries series)
+{
+	static const char* names[kSeriesCount] = {
+		"frame_ms", "physics_ms", "render_ms", "gpu_ms", "draw_calls",
+		"packets", "binds", "visible"
+	};
+
+	return names[series];
+}
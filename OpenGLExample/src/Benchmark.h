@@ -0,0 +1,42 @@
+#pragma once
+
+// std
+#include <string>
+#include <utility>
+#include <vector>
+
+// Per-frame values a benchmark run collects
+enum BenchmarkSeries {
+	kSeriesFrame = 0,	// ms, CPU and GPU since glFinish ends each frame
+	kSeriesPhysics,		// ms in stepSimulation
+	kSeriesRender,		// ms in renderScene
+	kSeriesGpu,			// ms of GPU time, from the profiler's timer queries
+	kSeriesDrawCalls,	// after the render queue merges packets
+	kSeriesPackets,
+	kSeriesBinds,
+	kSeriesVisible,
+	kSeriesCount
+};
+
+// Keeps every sample of a scripted run and writes min, mean, percentiles and
+// max of each series to a JSON file, next to the parameters the scene was
+// built with, so runs on different builds can be compared.
+class Benchmark
+{
+public:
+	void setParameter(const std::string& name, int value);
+	void setParameter(const std::string& name, const std::string& value);
+
+	void addSample(BenchmarkSeries series, float value);
+
+	// Returns false if the file can't be opened
+	bool write(const std::string& filename);
+
+	static const char* getSeriesName(BenchmarkSeries series);
+
+private:
+
+	// Values are kept already formatted as JSON
+	std::vector<std::pair<std::string, std::string>>	parameters;
+	std::vector<float>									samples[kSeriesCount];
+};
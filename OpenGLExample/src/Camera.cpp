@@ -7,6 +7,9 @@ Camera::Camera(GLfloat FOV, GLfloat width, GLfloat height, GLfloat nearPlane, GL
 	glm::vec3 cameraUp		= glm::vec3(0.0f, 1.0f, 0.0f);
 	viewMatrix				= glm::lookAt(cameraPos, cameraFront, cameraUp);
 	projectionMatrix		= glm::perspective(FOV, width / height, nearPlane, farPlane);
+	frustum					= Frustum(projectionMatrix * viewMatrix);
+	nearDistance			= nearPlane;
+	farDistance				= farPlane;
 }
 
 Camera::~Camera()
@@ -27,3 +30,33 @@ glm::vec3 Camera::getCameraPosition()
 {
 	return cameraPos;
 }
+
+const Frustum& Camera::getFrustum()
+{
+	return frustum;
+}
+
+float Camera::getNearPlane()
+{
+	return nearDistance;
+}
+
+float Camera::getFarPlane()
+{
+	return farDistance;
+}
+
+float Camera::getProjectedSize(glm::vec3 center, float radius)
+{
+	float distance = glm::length(center - cameraPos);
+
+	// Inside the sphere, treat it as covering everything
+	if (distance <= radius)
+	{
+		return 1.0f;
+	}
+
+	// projection[1][1] is 1 / tan(fov / 2), so this is the projected
+	// diameter over the viewport height
+	return radius * projectionMatrix[1][1] / distance;
+}
@@ -4,6 +4,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "Frustum.h"
+
 class Camera
 {
 public:
@@ -13,10 +15,20 @@ public:
 	glm::mat4 getViewMatrix();
 	glm::mat4 getProjectionMatrix();
 	glm::vec3 getCameraPosition();
+	const Frustum& getFrustum();
+	float getNearPlane();
+	float getFarPlane();
+
+	// Fraction of the viewport height covered by a sphere, used to pick a
+	// level of detail. Above 1 when it fills the screen.
+	float getProjectedSize(glm::vec3 center, float radius);
 
 private:
 
 	glm::mat4 viewMatrix;
 	glm::mat4 projectionMatrix;
 	glm::vec3 cameraPos;
+	Frustum	  frustum;
+	float	  nearDistance;
+	float	  farDistance;
 };
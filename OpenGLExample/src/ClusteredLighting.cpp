@@ -0,0 +1,260 @@
+#include "ClusteredLighting.h"
+
+#include "ShaderProgram.h"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Worst case padding for the three aligned allocations
+static const GLsizeiptr kAlignmentSlack = 3 * 256;
+
+ClusteredLighting::ClusteredLighting(Camera* inCamera, StreamBuffer* inStream,
+	int width, int height)
+{
+	camera			= inCamera;
+	stream			= inStream;
+	assignedCount	= 0;
+
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+
+	tileWidth	= (float)width / kClustersX;
+	tileHeight	= (float)height / kClustersY;
+
+	// Slices grow with depth so clusters stay roughly cube shaped:
+	// slice = log(depth) * sliceScale - sliceBias
+	nearPlane	= camera->getNearPlane();
+	farPlane	= camera->getFarPlane();
+	sliceScale	= kClustersZ / logf(farPlane / nearPlane);
+	sliceBias	= logf(nearPlane) * sliceScale;
+
+	counts.resize(kClusterCount);
+	cursors.resize(kClusterCount);
+}
+
+int ClusteredLighting::addLight(glm::vec3 position, float radius,
+	glm::vec3 color)
+{
+	if ((int)lights.size() >= kMaxLights)
+	{
+		return -1;
+	}
+
+	PointLight light;
+	light.positionRadius	= glm::vec4(position, radius);
+	light.color				= glm::vec4(color, 1.0f);
+
+	lights.push_back(light);
+
+	return (int)lights.size() - 1;
+}
+
+void ClusteredLighting::setLightPosition(int index, glm::vec3 position)
+{
+	lights[index].positionRadius = glm::vec4(position,
+		lights[index].positionRadius.w);
+}
+
+int ClusteredLighting::getLightCount()
+{
+	return (int)lights.size();
+}
+
+void ClusteredLighting::update()
+{
+	glm::mat4 view = camera->getViewMatrix();
+
+	std::fill(counts.begin(), counts.end(), 0);
+	ranges.resize(lights.size());
+	assignedCount = 0;
+
+	// First pass counts the lights in each cluster. Lights past the index
+	// budget are dropped for the frame.
+	for (size_t i = 0; i < lights.size(); i++)
+	{
+		ClusterRange& range = ranges[i];
+
+		if (!getClusterRange(lights[i], view, &range))
+		{
+			range.minX = -1;
+			continue;
+		}
+
+		int covered = (range.maxX - range.minX + 1) *
+			(range.maxY - range.minY + 1) * (range.maxZ - range.minZ + 1);
+
+		if (assignedCount + covered > kMaxLightIndices)
+		{
+			range.minX = -1;
+			continue;
+		}
+
+		assignedCount += covered;
+
+		for (int z = range.minZ; z <= range.maxZ; z++)
+		{
+			for (int y = range.minY; y <= range.maxY; y++)
+			{
+				for (int x = range.minX; x <= range.maxX; x++)
+				{
+					counts[x + kClustersX * (y + kClustersY * z)]++;
+				}
+			}
+		}
+	}
+
+	// Empty ranges can't be bound, every allocation holds at least one
+	// element
+	GLintptr lightOffset;
+	GLintptr clusterOffset;
+	GLintptr indexOffset;
+
+	GLsizeiptr lightSize	= sizeof(PointLight) *
+		std::max(lights.size(), (size_t)1);
+	GLsizeiptr clusterSize	= sizeof(GLuint) * 2 * kClusterCount;
+	GLsizeiptr indexSize	= sizeof(GLuint) * std::max(assignedCount, 1);
+
+	PointLight* lightData = (PointLight*)stream->allocate(lightSize,
+		alignment, &lightOffset);
+	GLuint* clusterData = (GLuint*)stream->allocate(clusterSize, alignment,
+		&clusterOffset);
+	GLuint* indexData = (GLuint*)stream->allocate(indexSize, alignment,
+		&indexOffset);
+
+	// The stream is sized with getFrameSize(), this only guards against misuse
+	if (lightData == NULL || clusterData == NULL || indexData == NULL)
+	{
+		return;
+	}
+
+	if (!lights.empty())
+	{
+		memcpy(lightData, lights.data(), sizeof(PointLight) * lights.size());
+	}
+
+	// Each cluster's list starts where the previous one ends. The stream is
+	// write-only memory, so the fill cursors stay on the CPU.
+	GLuint offset = 0;
+
+	for (int cluster = 0; cluster < kClusterCount; cluster++)
+	{
+		clusterData[2 * cluster]		= offset;
+		clusterData[2 * cluster + 1]	= counts[cluster];
+		cursors[cluster]				= offset;
+
+		offset += counts[cluster];
+	}
+
+	// Second pass writes the light indices in place
+	for (size_t i = 0; i < lights.size(); i++)
+	{
+		const ClusterRange& range = ranges[i];
+
+		if (range.minX < 0)
+		{
+			continue;
+		}
+
+		for (int z = range.minZ; z <= range.maxZ; z++)
+		{
+			for (int y = range.minY; y <= range.maxY; y++)
+			{
+				for (int x = range.minX; x <= range.maxX; x++)
+				{
+					indexData[cursors[x + kClustersX * (y + kClustersY * z)]++] =
+						(GLuint)i;
+				}
+			}
+		}
+	}
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kLightDataBinding,
+		stream->getBuffer(), lightOffset, lightSize);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kClusterDataBinding,
+		stream->getBuffer(), clusterOffset, clusterSize);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kLightIndexBinding,
+		stream->getBuffer(), indexOffset, indexSize);
+}
+
+glm::vec4 ClusteredLighting::getClusterParams()
+{
+	return glm::vec4(tileWidth, tileHeight, sliceScale, sliceBias);
+}
+
+int ClusteredLighting::getAssignedCount()
+{
+	return assignedCount;
+}
+
+GLsizeiptr ClusteredLighting::getFrameSize()
+{
+	return sizeof(PointLight) * kMaxLights + sizeof(GLuint) * 2 * kClusterCount +
+		sizeof(GLuint) * kMaxLightIndices + kAlignmentSlack;
+}
+
+bool ClusteredLighting::getClusterRange(const PointLight& light,
+	const glm::mat4& view, ClusterRange* range)
+{
+	glm::vec3 position	= glm::vec3(light.positionRadius);
+	float radius		= light.positionRadius.w;
+
+	if (!camera->getFrustum().intersectsSphere(position, radius))
+	{
+		return false;
+	}
+
+	// The camera looks down -z in view space
+	glm::vec3 center	= glm::vec3(view * glm::vec4(position, 1.0f));
+	float nearDepth		= -center.z - radius;
+	float farDepth		= -center.z + radius;
+
+	range->minZ = getSlice(std::max(nearDepth, nearPlane));
+	range->maxZ = getSlice(std::min(farDepth, farPlane));
+
+	// Crossing the near plane the projected bounds are unbounded
+	if (nearDepth <= nearPlane)
+	{
+		range->minX = 0;
+		range->maxX = kClustersX - 1;
+		range->minY = 0;
+		range->maxY = kClustersY - 1;
+
+		return true;
+	}
+
+	// x / depth is monotonic in depth, so the bounding box's extremes are at
+	// its nearest or farthest face
+	glm::mat4 projection = camera->getProjectionMatrix();
+
+	float minX = projection[0][0] * std::min((center.x - radius) / nearDepth,
+		(center.x - radius) / farDepth);
+	float maxX = projection[0][0] * std::max((center.x + radius) / nearDepth,
+		(center.x + radius) / farDepth);
+	float minY = projection[1][1] * std::min((center.y - radius) / nearDepth,
+		(center.y - radius) / farDepth);
+	float maxY = projection[1][1] * std::max((center.y + radius) / nearDepth,
+		(center.y + radius) / farDepth);
+
+	// Normalized device coordinates to tiles, gl_FragCoord counts from the
+	// bottom left like NDC does
+	auto toTile = [](float ndc, int tileCount)
+	{
+		int tile = (int)floorf((ndc * 0.5f + 0.5f) * tileCount);
+		return std::min(std::max(tile, 0), tileCount - 1);
+	};
+
+	range->minX = toTile(minX, kClustersX);
+	range->maxX = toTile(maxX, kClustersX);
+	range->minY = toTile(minY, kClustersY);
+	range->maxY = toTile(maxY, kClustersY);
+
+	return true;
+}
+
+int ClusteredLighting::getSlice(float depth)
+{
+	int slice = (int)floorf(logf(depth) * sliceScale - sliceBias);
+
+	return std::min(std::max(slice, 0), kClustersZ - 1);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "StreamBuffer.h"
+
+// std
+#include <vector>
+
+// GPU layout of one point light, std430 in LitTexturedModel.fs
+struct PointLight
+{
+	glm::vec4 positionRadius;	// xyz world position, w = range
+	glm::vec4 color;
+};
+
+// Point lights for clustered forward shading. The view frustum is split
+// into kClustersX x kClustersY screen tiles and kClustersZ slices spaced
+// exponentially in depth. Each frame every light is binned into the
+// clusters its bounding box covers, and the lit shader only loops over the
+// lights listed for the fragment's cluster. Lights, per-cluster ranges and
+// the light index list go into the frame's stream buffer as three shader
+// storage ranges.
+class ClusteredLighting
+{
+public:
+	static const int kClustersX = 16;
+	static const int kClustersY = 9;
+	static const int kClustersZ = 24;
+	static const int kClusterCount = kClustersX * kClustersY * kClustersZ;
+	static const int kMaxLights = 1024;
+	static const int kMaxLightIndices = 64 * 1024;	// per frame
+
+	ClusteredLighting(Camera* inCamera, StreamBuffer* inStream, int width,
+		int height);
+
+	// Returns the light's index, or -1 past kMaxLights
+	int addLight(glm::vec3 position, float radius, glm::vec3 color);
+	void setLightPosition(int index, glm::vec3 position);
+	int getLightCount();
+
+	// Bins the lights and writes them into the stream, then binds the
+	// storage ranges. Call between the stream's beginFrame() and flush().
+	void update();
+
+	// x, y = tile size in pixels, z, w = slice scale and bias for log(depth)
+	glm::vec4 getClusterParams();
+
+	// Light references over all clusters last frame
+	int getAssignedCount();
+
+	// Most update() writes into the stream in one frame, for sizing it
+	static GLsizeiptr getFrameSize();
+
+private:
+
+	// Clusters one light covers, inclusive
+	struct ClusterRange
+	{
+		int minX, maxX;
+		int minY, maxY;
+		int minZ, maxZ;
+	};
+
+	bool getClusterRange(const PointLight& light, const glm::mat4& view,
+		ClusterRange* range);
+	int getSlice(float depth);
+
+	Camera*						camera;
+	StreamBuffer*				stream;
+	GLint						alignment;	// GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+	float						tileWidth;
+	float						tileHeight;
+	float						nearPlane;
+	float						farPlane;
+	float						sliceScale;
+	float						sliceBias;
+	std::vector<PointLight>		lights;
+	std::vector<ClusterRange>	ranges;		// per light, minX < 0 if unseen
+	std::vector<GLuint>			counts;		// per cluster
+	std::vector<GLuint>			cursors;	// per cluster, next index slot
+	int							assignedCount;
+};
@@ -0,0 +1,152 @@
+#include "CollisionEvents.h"
+
+// std
+#include <algorithm>
+
+static_assert(kCollisionTagCount <= 32, "pairMasks holds one bit per tag");
+
+CollisionEvents::CollisionEvents()
+{
+	for (unsigned int& mask : pairMasks)
+	{
+		mask = 0;
+	}
+}
+
+void CollisionEvents::setTag(btCollisionObject* object, CollisionTag tag)
+{
+	object->setUserIndex(tag);
+}
+
+CollisionTag CollisionEvents::getTag(const btCollisionObject* object)
+{
+	// Bullet's default user index is -1
+	int index = object->getUserIndex();
+
+	return index > 0 && index < kCollisionTagCount ? (CollisionTag)index :
+		kTagNone;
+}
+
+void CollisionEvents::subscribe(CollisionTag tagA, CollisionTag tagB,
+	CollisionCallback callback)
+{
+	pairMasks[tagA] |= 1u << tagB;
+	pairMasks[tagB] |= 1u << tagA;
+
+	Subscription subscription;
+	subscription.tagA		= tagA;
+	subscription.tagB		= tagB;
+	subscription.callback	= callback;
+
+	subscriptions.push_back(subscription);
+}
+
+void CollisionEvents::update(btDynamicsWorld* dynamicsWorld)
+{
+	btDispatcher* dispatcher = dynamicsWorld->getDispatcher();
+	int numManifolds = dispatcher->getNumManifolds();
+
+	current.clear();
+
+	for (int i = 0; i < numManifolds; i++)
+	{
+		btPersistentManifold* manifold =
+			dispatcher->getManifoldByIndexInternal(i);
+
+		// Overlapping bounds without touching
+		if (manifold->getNumContacts() == 0)
+		{
+			continue;
+		}
+
+		Contact contact;
+		contact.objectA = manifold->getBody0();
+		contact.objectB = manifold->getBody1();
+
+		if ((pairMasks[getTag(contact.objectA)] &
+			(1u << getTag(contact.objectB))) == 0)
+		{
+			continue;
+		}
+
+		if (contact.objectB < contact.objectA)
+		{
+			std::swap(contact.objectA, contact.objectB);
+		}
+
+		current.push_back(contact);
+	}
+
+	std::sort(current.begin(), current.end());
+	current.erase(std::unique(current.begin(), current.end()), current.end());
+
+	// Walk both sorted lists, a pair only in current has just started
+	// touching and one only in previous has just separated
+	size_t p = 0;
+	size_t c = 0;
+
+	while (p < previous.size() || c < current.size())
+	{
+		if (p == previous.size() || (c < current.size() &&
+			current[c] < previous[p]))
+		{
+			dispatch(kContactBegin, current[c++]);
+		}
+		else if (c == current.size() || previous[p] < current[c])
+		{
+			dispatch(kContactEnd, previous[p++]);
+		}
+		else
+		{
+			p++;
+			c++;
+		}
+	}
+
+	previous.swap(current);
+}
+
+int CollisionEvents::getContactCount()
+{
+	return (int)previous.size();
+}
+
+void CollisionEvents::dispatch(CollisionEventType type, const Contact& contact)
+{
+	CollisionTag tagA = getTag(contact.objectA);
+	CollisionTag tagB = getTag(contact.objectB);
+
+	for (Subscription& subscription : subscriptions)
+	{
+		CollisionEvent event;
+		event.type = type;
+
+		if (subscription.tagA == tagA && subscription.tagB == tagB)
+		{
+			event.objectA = contact.objectA;
+			event.objectB = contact.objectB;
+		}
+		else if (subscription.tagA == tagB && subscription.tagB == tagA)
+		{
+			event.objectA = contact.objectB;
+			event.objectB = contact.objectA;
+		}
+		else
+		{
+			continue;
+		}
+
+		subscription.callback(event);
+	}
+}
+
+bool CollisionEvents::Contact::operator<(const Contact& other) const
+{
+	return objectA != other.objectA ? objectA < other.objectA :
+		objectB < other.objectB;
+}
+
+bool CollisionEvents::Contact::operator==(const Contact& other) const
+{
+	return objectA == other.objectA && objectB == other.objectB;
+}
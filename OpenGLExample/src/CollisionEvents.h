@@ -0,0 +1,83 @@
+#pragma once
+
+#include "bullet/btBulletDynamicsCommon.h"
+
+// std
+#include <functional>
+#include <vector>
+
+// Category of a collision object, stored in its user index. Objects that were
+// never tagged read as kTagNone.
+enum CollisionTag {
+	kTagNone = 0,
+	kTagHero,
+	kTagEnemy,
+	kTagGround,
+	kTagProp,
+	kCollisionTagCount
+};
+
+enum CollisionEventType {
+	kContactBegin = 0,
+	kContactEnd
+};
+
+// objectA carries the first tag the subscriber asked for, objectB the second
+struct CollisionEvent
+{
+	CollisionEventType			type;
+	const btCollisionObject*	objectA;
+	const btCollisionObject*	objectB;
+};
+
+typedef std::function<void(const CollisionEvent&)> CollisionCallback;
+
+// Reports when two tagged objects start and stop touching. Only pairs of tags
+// somebody subscribed to are tracked, every other manifold is dropped after
+// two integer lookups, so thousands of untracked contacts cost next to
+// nothing.
+class CollisionEvents
+{
+public:
+	CollisionEvents();
+
+	static void setTag(btCollisionObject* object, CollisionTag tag);
+	static CollisionTag getTag(const btCollisionObject* object);
+
+	// Callbacks run from update(), they may move bodies but must not subscribe
+	void subscribe(CollisionTag tagA, CollisionTag tagB,
+		CollisionCallback callback);
+
+	// Diffs this tick's contacts against the last tick's and dispatches the
+	// changes. Call from the world's internal tick callback.
+	void update(btDynamicsWorld* dynamicsWorld);
+
+	int getContactCount();	// tracked pairs touching after the last update
+
+private:
+
+	// Ordered by address so the same pair always compares equal
+	struct Contact
+	{
+		const btCollisionObject* objectA;
+		const btCollisionObject* objectB;
+
+		bool operator<(const Contact& other) const;
+		bool operator==(const Contact& other) const;
+	};
+
+	struct Subscription
+	{
+		CollisionTag		tagA;
+		CollisionTag		tagB;
+		CollisionCallback	callback;
+	};
+
+	void dispatch(CollisionEventType type, const Contact& contact);
+
+	// Bit b of pairMasks[a] is set when tags a and b have a subscriber
+	unsigned int				pairMasks[kCollisionTagCount];
+	std::vector<Subscription>	subscriptions;
+	std::vector<Contact>		previous;	// sorted
+	std::vector<Contact>		current;
+};
@@ -0,0 +1,152 @@
+#include "EntityStore.h"
+
+// std
+#include <iostream>
+
+EntityStore::EntityStore(size_t inCapacity)
+{
+	capacity = inCapacity;
+
+	transforms.reserve(capacity);
+	normalMatrices.reserve(capacity);
+	scales.reserve(capacity);
+	bodies.reserve(capacity);
+	renderBatches.reserve(capacity);
+	materials.reserve(capacity);
+	tags.reserve(capacity);
+	indexSlots.reserve(capacity);
+
+	slotIndices.assign(capacity, kInvalidEntitySlot);
+	slotGenerations.assign(capacity, 0);
+
+	// Hand out low slots first
+	freeSlots.reserve(capacity);
+
+	for (size_t slot = capacity; slot > 0; slot--)
+	{
+		freeSlots.push_back((uint32_t)slot - 1);
+	}
+}
+
+Entity EntityStore::spawn(btRigidBody* body, glm::vec3 scale, int renderBatch,
+	glm::vec2 material, CollisionTag tag)
+{
+	Entity entity;
+	entity.slot			= kInvalidEntitySlot;
+	entity.generation	= 0;
+
+	if (freeSlots.empty())
+	{
+		std::cout << "Entity store is full, " << capacity << " entities" <<
+			'\n';
+		return entity;
+	}
+
+	entity.slot = freeSlots.back();
+	freeSlots.pop_back();
+
+	entity.generation = slotGenerations[entity.slot];
+
+	slotIndices[entity.slot] = (uint32_t)transforms.size();
+	indexSlots.push_back(entity.slot);
+
+	transforms.push_back(glm::mat4(1.0f));
+	normalMatrices.push_back(NormalMatrix());
+	scales.push_back(scale);
+	bodies.push_back(body);
+	renderBatches.push_back(renderBatch);
+	materials.push_back(material);
+	tags.push_back(tag);
+
+	CollisionEvents::setTag(body, tag);
+
+	return entity;
+}
+
+void EntityStore::despawn(Entity entity)
+{
+	int index = findIndex(entity);
+
+	if (index < 0)
+	{
+		return;
+	}
+
+	// Fill the hole with the last entity so the arrays stay packed
+	size_t last = transforms.size() - 1;
+
+	transforms[index]		= transforms[last];
+	normalMatrices[index]	= normalMatrices[last];
+	scales[index]			= scales[last];
+	bodies[index]			= bodies[last];
+	renderBatches[index]	= renderBatches[last];
+	materials[index]		= materials[last];
+	tags[index]				= tags[last];
+	indexSlots[index]		= indexSlots[last];
+
+	slotIndices[indexSlots[index]] = (uint32_t)index;
+
+	transforms.pop_back();
+	normalMatrices.pop_back();
+	scales.pop_back();
+	bodies.pop_back();
+	renderBatches.pop_back();
+	materials.pop_back();
+	tags.pop_back();
+	indexSlots.pop_back();
+
+	slotIndices[entity.slot] = kInvalidEntitySlot;
+	slotGenerations[entity.slot]++;
+	freeSlots.push_back(entity.slot);
+}
+
+bool EntityStore::isAlive(Entity entity)
+{
+	return findIndex(entity) >= 0;
+}
+
+btRigidBody* EntityStore::getBody(Entity entity)
+{
+	int index = findIndex(entity);
+
+	return index < 0 ? NULL : bodies[index];
+}
+
+void EntityStore::updateTransform(size_t index)
+{
+	btTransform t;
+	bodies[index]->getMotionState()->getWorldTransform(t);
+
+	glm::mat4& model = transforms[index];
+	t.getOpenGLMatrix(glm::value_ptr(model));
+
+	const glm::vec3& scale = scales[index];
+
+	model[0] *= scale.x;
+	model[1] *= scale.y;
+	model[2] *= scale.z;
+
+	// The upper 3x3 is a rotation times a scale, so its inverse transpose
+	// is the rotation over the scale. No general inverse needed.
+	NormalMatrix& normal = normalMatrices[index];
+	normal.columns[0] = model[0] / (scale.x * scale.x);
+	normal.columns[1] = model[1] / (scale.y * scale.y);
+	normal.columns[2] = model[2] / (scale.z * scale.z);
+}
+
+size_t EntityStore::getCount()
+{
+	return transforms.size();
+}
+
+int EntityStore::findIndex(Entity entity)
+{
+	if (entity.slot >= capacity ||
+		slotGenerations[entity.slot] != entity.generation ||
+		slotIndices[entity.slot] == kInvalidEntitySlot)
+	{
+		return -1;
+	}
+
+	return (int)slotIndices[entity.slot];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include "bullet/btBulletDynamicsCommon.h"
+
+#include "CollisionEvents.h"
+
+// std
+#include <cstdint>
+#include <vector>
+
+// Stable reference to an entity. The generation changes when the slot is
+// reused, so a handle to a despawned entity is never mistaken for its
+// successor.
+struct Entity
+{
+	uint32_t slot;
+	uint32_t generation;
+};
+
+const uint32_t kInvalidEntitySlot = 0xffffffff;
+
+// Inverse transpose of a model matrix's upper 3x3, for transforming
+// normals. Columns are padded to vec4, the std430 layout of a mat3.
+struct NormalMatrix
+{
+	glm::vec4 columns[3];
+};
+
+// Components of every live entity as parallel arrays, index i of each array
+// belongs to the same entity. Systems walk them front to back. Storage is
+// reserved up front for capacity entities, so spawning and despawning never
+// allocate. Despawning moves the last entity into the freed index, which
+// is why the arrays must not be indexed with a saved position.
+class EntityStore
+{
+public:
+	EntityStore(size_t inCapacity);
+
+	// Returns an entity with kInvalidEntitySlot when the store is full. The
+	// body stays owned by the caller, tag is written to it as well.
+	Entity spawn(btRigidBody* body, glm::vec3 scale, int renderBatch,
+		glm::vec2 material, CollisionTag tag);
+
+	// Does nothing for a handle that is no longer alive. The body is not
+	// touched, the caller removes it from the world and frees it.
+	void despawn(Entity entity);
+
+	bool isAlive(Entity entity);
+	btRigidBody* getBody(Entity entity);
+
+	// Copies the body's interpolated motion state into transforms[index],
+	// with the entity's scale applied, and derives its normal matrix. Only
+	// entities about to be drawn need it.
+	void updateTransform(size_t index);
+
+	size_t getCount();
+
+	std::vector<glm::mat4>		transforms;		// model matrices
+	std::vector<NormalMatrix>	normalMatrices;
+	std::vector<glm::vec3>		scales;
+	std::vector<btRigidBody*>	bodies;
+	std::vector<int>			renderBatches;	// InstancedRenderer batch, -1 for none
+	std::vector<glm::vec2>		materials;		// x = specular, y = ambient strength
+	std::vector<CollisionTag>	tags;
+
+private:
+
+	// -1 when the entity is no longer alive
+	int findIndex(Entity entity);
+
+	size_t					capacity;
+	std::vector<uint32_t>	slotIndices;	// per slot, index into the arrays
+	std::vector<uint32_t>	slotGenerations;
+	std::vector<uint32_t>	indexSlots;		// per index, the slot that owns it
+	std::vector<uint32_t>	freeSlots;
+};
@@ -0,0 +1,35 @@
+#include "FrameUniformBuffer.h"
+
+FrameUniformBuffer::FrameUniformBuffer(StreamBuffer* inStream)
+{
+	stream = inStream;
+
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+}
+
+void FrameUniformBuffer::update(Camera* camera, LightRenderer* light,
+	ClusteredLighting* lighting)
+{
+	GLintptr offset;
+	FrameData* data = (FrameData*)stream->allocate(sizeof(FrameData),
+		alignment, &offset);
+
+	// The stream is sized with room to spare, this only guards against misuse
+	if (data == NULL)
+	{
+		return;
+	}
+
+	data->vp			= camera->getProjectionMatrix() * camera->getViewMatrix();
+	data->cameraPos		= glm::vec4(camera->getCameraPosition(), 1.0f);
+	data->lightPos		= glm::vec4(light->getPosition(), 1.0f);
+	data->lightColor	= glm::vec4(light->getColor(), 1.0f);
+	data->clusterParams	= lighting->getClusterParams();
+	data->depthParams	= glm::vec4(camera->getNearPlane(),
+		camera->getFarPlane(), 0.0f, 0.0f);
+	data->clusterGrid	= glm::uvec4(ClusteredLighting::kClustersX,
+		ClusteredLighting::kClustersY, ClusteredLighting::kClustersZ, 0);
+
+	glBindBufferRange(GL_UNIFORM_BUFFER, kFrameDataBinding, stream->getBuffer(),
+		offset, sizeof(FrameData));
+}
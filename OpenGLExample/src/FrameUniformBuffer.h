@@ -0,0 +1,43 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "Camera.h"
+#include "ClusteredLighting.h"
+#include "LightRenderer.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+
+// CPU mirror of the std140 FrameData block in Assets/Shaders/FrameData.glsl. vec3
+// values are padded to vec4 to match std140 alignment.
+struct FrameData
+{
+	glm::mat4 vp;
+	glm::vec4 cameraPos;
+	glm::vec4 lightPos;
+	glm::vec4 lightColor;
+	glm::vec4 clusterParams;	// see ClusteredLighting::getClusterParams()
+	glm::vec4 depthParams;		// x = near plane, y = far plane
+	glm::uvec4 clusterGrid;		// clusters along x, y and z
+};
+
+static_assert(sizeof(FrameData) == 160, "FrameData must match std140 layout");
+
+// Camera, light and cluster data every program shares. Each frame it is written
+// into the frame's stream buffer partition and that range is bound to
+// kFrameDataBinding.
+class FrameUniformBuffer
+{
+public:
+	FrameUniformBuffer(StreamBuffer* inStream);
+
+	// Call between the stream's beginFrame() and flush()
+	void update(Camera* camera, LightRenderer* light,
+		ClusteredLighting* lighting);
+
+private:
+
+	StreamBuffer*	stream;
+	GLint			alignment;	// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+};
@@ -0,0 +1,69 @@
+#include "Frustum.h"
+
+Frustum::Frustum()
+{
+	// Accepts everything until built from a matrix
+	for (int i = 0; i < kFrustumPlaneCount; i++)
+	{
+		planes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+	// Rows of the matrix, glm stores columns
+	glm::vec4 rows[4];
+
+	for (int row = 0; row < 4; row++)
+	{
+		rows[row] = glm::vec4(viewProjection[0][row], viewProjection[1][row],
+			viewProjection[2][row], viewProjection[3][row]);
+	}
+
+	// -w <= x, y, z <= w in clip space
+	planes[kFrustumLeft]	= rows[3] + rows[0];
+	planes[kFrustumRight]	= rows[3] - rows[0];
+	planes[kFrustumBottom]	= rows[3] + rows[1];
+	planes[kFrustumTop]		= rows[3] - rows[1];
+	planes[kFrustumNear]	= rows[3] + rows[2];
+	planes[kFrustumFar]		= rows[3] - rows[2];
+
+	for (int i = 0; i < kFrustumPlaneCount; i++)
+	{
+		planes[i] /= glm::length(glm::vec3(planes[i]));
+	}
+}
+
+bool Frustum::intersectsAabb(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const
+{
+	for (int i = 0; i < kFrustumPlaneCount; i++)
+	{
+		const glm::vec4& plane = planes[i];
+
+		// The corner furthest along the plane normal
+		glm::vec3 positive(
+			plane.x >= 0.0f ? aabbMax.x : aabbMin.x,
+			plane.y >= 0.0f ? aabbMax.y : aabbMin.y,
+			plane.z >= 0.0f ? aabbMax.z : aabbMin.z);
+
+		if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const
+{
+	for (int i = 0; i < kFrustumPlaneCount; i++)
+	{
+		if (glm::dot(glm::vec3(planes[i]), center) + planes[i].w < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+enum FrustumPlane {
+	kFrustumLeft = 0,
+	kFrustumRight,
+	kFrustumBottom,
+	kFrustumTop,
+	kFrustumNear,
+	kFrustumFar,
+	kFrustumPlaneCount
+};
+
+// The six planes of a view-projection matrix, normals pointing inwards and
+// normalised so dot(plane.xyz, p) + plane.w is the distance to the plane
+class Frustum
+{
+public:
+	Frustum();
+	Frustum(const glm::mat4& viewProjection);
+
+	// Conservative, boxes straddling a corner may pass
+	bool intersectsAabb(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const;
+	bool intersectsSphere(const glm::vec3& center, float radius) const;
+
+private:
+
+	glm::vec4 planes[kFrustumPlaneCount];
+};
@@ -0,0 +1,353 @@
+#include "GeometryRegistry.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+bool		GeometryRegistry::created = false;
+Geometry	GeometryRegistry::geometries[kMeshTypeCount];
+GLuint		GeometryRegistry::vaos[1 << kVertexStreamCount] = {};
+GLuint		GeometryRegistry::vbo = 0;
+GLuint		GeometryRegistry::ebo = 0;
+GLenum		GeometryRegistry::indexType = GL_UNSIGNED_INT;
+GLintptr	GeometryRegistry::streamOffsets[kVertexStreamCount] = {};
+
+// Bytes per vertex in each stream, 20 in all against 44 for a Vertex
+static const GLsizeiptr streamSizes[kVertexStreamCount] = {
+	sizeof(uint64_t),	// 4 halves
+	sizeof(uint32_t),	// 2 unorm16
+	sizeof(uint32_t),	// 2 snorm16
+	sizeof(uint32_t)	// 4 unorm8
+};
+
+// Tessellation per level and the smallest screen size it is used at. The
+// finest level matches the old fixed sphere so close-ups look the same.
+struct LodLevel
+{
+	int		detail;			// bands for UV spheres, subdivisions for icospheres
+	float	minScreenSize;
+};
+
+static const LodLevel sphereLods[] = {
+	{ kSphereBands, 0.25f },
+	{ 12, 0.08f },
+	{ 8, 0.02f },
+	{ 6, 0.0f }
+};
+
+static const LodLevel icosphereLods[] = {
+	{ 3, 0.25f },
+	{ 2, 0.08f },
+	{ 1, 0.02f },
+	{ 0, 0.0f }
+};
+
+// Folds the unit sphere onto a square, the lower hemisphere into the corners,
+// so a normal fits in two numbers with even precision everywhere
+static glm::vec2 encodeOctahedral(glm::vec3 normal)
+{
+	normal = normal / (fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z));
+
+	glm::vec2 encoded(normal.x, normal.y);
+
+	if (normal.z < 0.0f)
+	{
+		encoded.x = (1.0f - fabsf(normal.y)) * (normal.x >= 0.0f ? 1.0f : -1.0f);
+		encoded.y = (1.0f - fabsf(normal.x)) * (normal.y >= 0.0f ? 1.0f : -1.0f);
+	}
+
+	return encoded;
+}
+
+Geometry::Geometry()
+{
+	boundingRadius	= 0.0f;
+}
+
+const GeometryLod& Geometry::selectLod(float screenSize) const
+{
+	return lods[selectLodIndex(screenSize)];
+}
+
+int Geometry::selectLodIndex(float screenSize) const
+{
+	for (size_t i = 0; i + 1 < lods.size(); i++)
+	{
+		if (screenSize >= lods[i].minScreenSize)
+		{
+			return (int)i;
+		}
+	}
+
+	return (int)lods.size() - 1;
+}
+
+const Geometry* GeometryRegistry::get(MeshType meshType)
+{
+	if (!created)
+	{
+		create();
+	}
+
+	return &geometries[meshType];
+}
+
+GLuint GeometryRegistry::getVertexArray(VertexFormat format)
+{
+	if (!created)
+	{
+		create();
+	}
+
+	GLuint& vao = vaos[format];
+
+	if (vao == 0)
+	{
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+
+		setVertexFormat(format);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+		// unbind
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+	}
+
+	return vao;
+}
+
+GLuint GeometryRegistry::getIndexBuffer()
+{
+	if (!created)
+	{
+		create();
+	}
+
+	return ebo;
+}
+
+GLenum GeometryRegistry::getIndexType()
+{
+	if (!created)
+	{
+		create();
+	}
+
+	return indexType;
+}
+
+void GeometryRegistry::shutdown()
+{
+	if (!created)
+	{
+		return;
+	}
+
+	for (GLuint& vao : vaos)
+	{
+		if (vao != 0)
+		{
+			glDeleteVertexArrays(1, &vao);
+			vao = 0;
+		}
+	}
+
+	glDeleteBuffers(1, &vbo);
+	glDeleteBuffers(1, &ebo);
+
+	vbo		= 0;
+	ebo		= 0;
+	created	= false;
+
+	for (Geometry& geometry : geometries)
+	{
+		geometry = Geometry();
+	}
+}
+
+void GeometryRegistry::setVertexFormat(VertexFormat format)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+	// Each stream is tightly packed, the unorm and snorm ones are normalized
+	// back to floats by the fetch
+	if (format & 1 << kStreamPosition)
+	{
+		glEnableVertexAttribArray(kAttribPosition);
+		glVertexAttribPointer(kAttribPosition, 4, GL_HALF_FLOAT, GL_FALSE, 0,
+			(void*)streamOffsets[kStreamPosition]);
+	}
+
+	if (format & 1 << kStreamTexCoords)
+	{
+		glEnableVertexAttribArray(kAttribTexCoords);
+		glVertexAttribPointer(kAttribTexCoords, 2, GL_UNSIGNED_SHORT, GL_TRUE, 0,
+			(void*)streamOffsets[kStreamTexCoords]);
+	}
+
+	if (format & 1 << kStreamNormal)
+	{
+		glEnableVertexAttribArray(kAttribNormal);
+		glVertexAttribPointer(kAttribNormal, 2, GL_SHORT, GL_TRUE, 0,
+			(void*)streamOffsets[kStreamNormal]);
+	}
+
+	if (format & 1 << kStreamColor)
+	{
+		glEnableVertexAttribArray(kAttribColor);
+		glVertexAttribPointer(kAttribColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, 0,
+			(void*)streamOffsets[kStreamColor]);
+	}
+}
+
+void GeometryRegistry::create()
+{
+	std::vector<Vertex>		vertices;
+	std::vector<uint32_t>	indices;
+	std::vector<Vertex>		lodVertices;
+	std::vector<uint32_t>	lodIndices;
+	size_t					maxLevelVertices = 0;
+
+	// Every primitive is small, building them all up front costs less than
+	// a buffer per mesh type would in binds
+	for (int type = 0; type < kMeshTypeCount; type++)
+	{
+		MeshType meshType	= (MeshType)type;
+		Geometry& geometry	= geometries[meshType];
+
+		const LodLevel* levels	= NULL;
+		size_t levelCount		= 1;
+
+		if (meshType == kSphere)
+		{
+			levels		= sphereLods;
+			levelCount	= sizeof(sphereLods) / sizeof(sphereLods[0]);
+		}
+		else if (meshType == kIcosphere)
+		{
+			levels		= icosphereLods;
+			levelCount	= sizeof(icosphereLods) / sizeof(icosphereLods[0]);
+		}
+
+		for (size_t level = 0; level < levelCount; level++)
+		{
+			// Tables baked at compile time where there is one, otherwise
+			// generated. Either way the level ends up in the scratch vectors.
+			switch (meshType)
+			{
+			case kTriangle:
+				Mesh::setTableData(lodVertices, lodIndices, Mesh::getTriData());
+				break;
+			case kQuad:
+				Mesh::setTableData(lodVertices, lodIndices, Mesh::getQuadData());
+				break;
+			case kCube:
+				Mesh::setTableData(lodVertices, lodIndices, Mesh::getCubeData());
+				break;
+			case kSphere:
+				if (levels[level].detail == kSphereBands)
+				{
+					Mesh::setTableData(lodVertices, lodIndices,
+						Mesh::getSphereData());
+					break;
+				}
+
+				Mesh::setSphereData(lodVertices, lodIndices,
+					levels[level].detail, levels[level].detail);
+				break;
+			case kIcosphere:
+				Mesh::setIcosphereData(lodVertices, lodIndices,
+					levels[level].detail);
+				break;
+			default:
+				lodVertices.clear();
+				lodIndices.clear();
+				break;
+			}
+
+			// Indices stay relative to the level, the draw adds baseVertex
+			GeometryLod lod;
+			lod.indexCount		= (GLsizei)lodIndices.size();
+			lod.firstIndex		= (GLuint)indices.size();
+			lod.baseVertex		= (GLint)vertices.size();
+			lod.minScreenSize	= levels != NULL ? levels[level].minScreenSize : 0.0f;
+
+			geometry.lods.push_back(lod);
+
+			for (const Vertex& vertex : lodVertices)
+			{
+				geometry.boundingRadius = fmaxf(geometry.boundingRadius,
+					glm::length(vertex.pos));
+			}
+
+			maxLevelVertices = std::max(maxLevelVertices, lodVertices.size());
+
+			indices.insert(indices.end(), lodIndices.begin(),
+				lodIndices.end());
+			vertices.insert(vertices.end(), lodVertices.begin(),
+				lodVertices.end());
+		}
+	}
+
+	// Quantize into one range per stream
+	size_t vertexCount = vertices.size();
+	GLsizeiptr size = 0;
+
+	for (int stream = 0; stream < kVertexStreamCount; stream++)
+	{
+		streamOffsets[stream]	= size;
+		size					+= streamSizes[stream] * vertexCount;
+	}
+
+	std::vector<unsigned char> data(size);
+
+	uint64_t* positions	= (uint64_t*)&data[streamOffsets[kStreamPosition]];
+	uint32_t* texCoords	= (uint32_t*)&data[streamOffsets[kStreamTexCoords]];
+	uint32_t* normals	= (uint32_t*)&data[streamOffsets[kStreamNormal]];
+	uint32_t* colors	= (uint32_t*)&data[streamOffsets[kStreamColor]];
+
+	for (size_t i = 0; i < vertexCount; i++)
+	{
+		const Vertex& vertex = vertices[i];
+
+		positions[i]	= glm::packHalf4x16(glm::vec4(vertex.pos, 1.0f));
+		texCoords[i]	= glm::packUnorm2x16(vertex.texCoords);
+		normals[i]		= glm::packSnorm2x16(encodeOctahedral(vertex.normal));
+		colors[i]		= glm::packUnorm4x8(glm::vec4(vertex.color, 1.0f));
+	}
+
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, size, &data[0], GL_STATIC_DRAW);
+
+	// No VAO is bound to hold an element buffer, upload through the array
+	// target instead
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_ARRAY_BUFFER, ebo);
+
+	// Indices count from each level's base vertex, so only the largest level
+	// has to fit
+	if (maxLevelVertices < 65536)
+	{
+		std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+
+		indexType = GL_UNSIGNED_SHORT;
+		glBufferData(GL_ARRAY_BUFFER,
+			sizeof(uint16_t) * shortIndices.size(), &shortIndices[0],
+			GL_STATIC_DRAW);
+	}
+	else
+	{
+		indexType = GL_UNSIGNED_INT;
+		glBufferData(GL_ARRAY_BUFFER, sizeof(uint32_t) * indices.size(),
+			&indices[0], GL_STATIC_DRAW);
+	}
+
+	// unbind
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	created = true;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "Mesh.h"
+
+// std
+#include <vector>
+
+// One level of detail, a range of the shared index buffer. Indices count
+// from the level's own first vertex, draws add baseVertex.
+struct GeometryLod
+{
+	GLsizei	indexCount;
+	GLuint	firstIndex;		// into the shared index buffer
+	GLint	baseVertex;		// into the shared vertex buffer
+	float	minScreenSize;	// fraction of the viewport height covered
+};
+
+// Where one primitive and all of its levels of detail live in the shared
+// buffers
+struct Geometry
+{
+	Geometry();
+
+	// Finest level first, picks the first whose minScreenSize fits
+	const GeometryLod& selectLod(float screenSize) const;
+	int selectLodIndex(float screenSize) const;
+
+	float						boundingRadius;	// around the mesh origin
+	std::vector<GeometryLod>	lods;
+};
+
+// Vertex attribute locations shared by every program that reads a Vertex
+enum VertexAttribute {
+	kAttribPosition = 0,
+	kAttribTexCoords = 1,
+	kAttribNormal = 2,
+	kAttribColor = 3,
+	kAttribInstanceTransform = 4,	// uint, index into the transform buffer
+	kAttribInstanceMaterial = 8
+};
+
+// Attributes a program can read. Each is kept quantized in its own range of
+// the vertex buffer, so a VAO only fetches the ones its program consumes.
+enum VertexStream {
+	kStreamPosition = 0,	// half float xyz, w = 1
+	kStreamTexCoords,		// unorm16 uv
+	kStreamNormal,			// octahedral, snorm16 xy
+	kStreamColor,			// unorm8 rgb, a = 1
+	kVertexStreamCount
+};
+
+// Sets of VertexStream bits, one per kind of program
+enum VertexFormat {
+	kFormatFlat = 1 << kStreamPosition | 1 << kStreamColor,
+	kFormatLit = 1 << kStreamPosition | 1 << kStreamTexCoords |
+		1 << kStreamNormal
+};
+
+// Packs every MeshType and its levels of detail into one vertex buffer and
+// one index buffer the first time any of them is requested, so draws of
+// different meshes only differ in their index range and base vertex and can
+// share a VAO, or be merged into one multi-draw. Spheres get a chain of
+// coarser tessellations. The CPU-side vertex and index data is released as
+// soon as it has been uploaded. Indices are 16-bit when every level has
+// fewer than 65,536 vertices. Every primitive stays in the shared buffers
+// until shutdown(), whether or not anything still draws it.
+class GeometryRegistry
+{
+public:
+	static const Geometry* get(MeshType meshType);
+
+	// VAO reading the streams in format from the shared buffers, created on
+	// first use
+	static GLuint getVertexArray(VertexFormat format);
+	static GLuint getIndexBuffer();
+	static GLenum getIndexType();		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+
+	// Sets up the streams in format for the currently bound VAO
+	static void setVertexFormat(VertexFormat format);
+
+	// Deletes the buffers, call while the context is still current
+	static void shutdown();
+
+private:
+
+	static void create();
+
+	static bool		created;
+	static Geometry	geometries[kMeshTypeCount];
+	static GLuint	vaos[1 << kVertexStreamCount];	// by format
+	static GLuint	vbo;
+	static GLuint	ebo;
+	static GLenum	indexType;
+	static GLintptr	streamOffsets[kVertexStreamCount];	// into vbo
+};
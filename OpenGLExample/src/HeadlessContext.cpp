@@ -0,0 +1,211 @@
+#include "HeadlessContext.h"
+
+// std
+#include <iostream>
+
+HeadlessContext::HeadlessContext()
+{
+#ifdef OPENGL_EXAMPLE_EGL
+	display	= EGL_NO_DISPLAY;
+	context	= EGL_NO_CONTEXT;
+#else
+	window	= NULL;
+#endif
+
+	framebuffer	= 0;
+	colorBuffer	= 0;
+	depthBuffer	= 0;
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	if (framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteRenderbuffers(1, &depthBuffer);
+	}
+
+#ifdef OPENGL_EXAMPLE_EGL
+	if (display != EGL_NO_DISPLAY)
+	{
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+		if (context != EGL_NO_CONTEXT)
+		{
+			eglDestroyContext(display, context);
+		}
+
+		eglTerminate(display);
+	}
+#else
+	if (window != NULL)
+	{
+		glfwDestroyWindow(window);
+	}
+#endif
+}
+
+bool HeadlessContext::create(int width, int height)
+{
+	if (!createContext())
+	{
+		return false;
+	}
+
+	// Core profile entry points are only found with this set
+	glewExperimental = GL_TRUE;
+
+#ifdef OPENGL_EXAMPLE_EGL
+	// glewInit() would look for a GLX or WGL context
+	GLenum result = glewContextInit();
+#else
+	GLenum result = glewInit();
+#endif
+
+	if (result != GLEW_OK)
+	{
+		std::cout << "Can't initialise GLEW: " << glewGetErrorString(result) <<
+			'\n';
+		return false;
+	}
+
+	glGenRenderbuffers(1, &colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+	glGenRenderbuffers(1, &depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+	// unbind
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+		GL_RENDERBUFFER, colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+		GL_RENDERBUFFER, depthBuffer);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Offscreen framebuffer is incomplete" << '\n';
+		return false;
+	}
+
+	glViewport(0, 0, width, height);
+
+	return true;
+}
+
+#ifdef OPENGL_EXAMPLE_EGL
+
+bool HeadlessContext::createContext()
+{
+	// Mesa's surfaceless platform needs neither a GPU nor a display server
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress(
+			"eglGetPlatformDisplayEXT");
+
+	if (getPlatformDisplay != NULL)
+	{
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+			EGL_DEFAULT_DISPLAY, NULL);
+	}
+
+	if (display == EGL_NO_DISPLAY)
+	{
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+	{
+		std::cout << "Can't initialise EGL" << '\n';
+		return false;
+	}
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		std::cout << "EGL has no desktop OpenGL" << '\n';
+		return false;
+	}
+
+	// The surface type defaults to EGL_WINDOW_BIT, which no surfaceless
+	// config has
+	const EGLint configAttribs[] = {
+		EGL_SURFACE_TYPE, 0,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+
+	EGLConfig config;
+	EGLint configCount = 0;
+
+	if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) ||
+		configCount == 0)
+	{
+		std::cout << "No EGL config for desktop OpenGL" << '\n';
+		return false;
+	}
+
+	// The shaders are GLSL 4.50
+	const EGLint contextAttribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 5,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+
+	context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+
+	if (context == EGL_NO_CONTEXT)
+	{
+		std::cout << "Can't create an OpenGL 4.5 context" << '\n';
+		return false;
+	}
+
+	// No surface, everything is drawn into the framebuffer object
+	if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+	{
+		std::cout << "Can't make the EGL context current" << '\n';
+		return false;
+	}
+
+	return true;
+}
+
+#else
+
+bool HeadlessContext::createContext()
+{
+	if (!glfwInit())
+	{
+		std::cout << "Can't initialise GLFW" << '\n';
+		return false;
+	}
+
+	// The shaders are GLSL 4.50
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+	window = glfwCreateWindow(1, 1, "", NULL, NULL);
+
+	if (window == NULL)
+	{
+		std::cout << "Can't create a hidden window with an OpenGL 4.5 context" <<
+			'\n';
+		return false;
+	}
+
+	glfwMakeContextCurrent(window);
+
+	// Frames are never presented, nothing should wait for vsync
+	glfwSwapInterval(0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// Builds with OPENGL_EXAMPLE_EGL defined (the experimental Linux CMake
+// build) get a surfaceless EGL context, so Mesa's llvmpipe can render on
+// hosts without a GPU or display server. Everywhere else a hidden GLFW
+// window provides the context, which still needs a display and a driver.
+#ifdef OPENGL_EXAMPLE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+// An OpenGL 4.5 context that never shows anything on screen. Rendering goes
+// to a framebuffer object the size of the window the game normally opens,
+// left bound for the whole run.
+class HeadlessContext
+{
+public:
+	HeadlessContext();
+	~HeadlessContext();
+
+	// Makes the context current, initialises GLEW and binds the offscreen
+	// framebuffer. Returns false if any of it fails.
+	bool create(int width, int height);
+
+private:
+
+	bool createContext();
+
+#ifdef OPENGL_EXAMPLE_EGL
+	EGLDisplay	display;
+	EGLContext	context;
+#else
+	GLFWwindow*	window;
+#endif
+
+	GLuint		framebuffer;
+	GLuint		colorBuffer;
+	GLuint		depthBuffer;
+};
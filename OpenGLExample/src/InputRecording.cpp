@@ -0,0 +1,308 @@
+#include "InputRecording.h"
+
+#include "ClusteredLighting.h"
+#include "Mesh.h"
+
+// std
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+static const char		kRecordingMagic[4]	= { 'O', 'G', 'L', 'R' };
+static const uint32_t	kRecordingVersion	= 1;
+
+// Far past any stress scene, only there to refuse corrupt headers
+static const int32_t	kMaxRecordedBodies	= 1000000;
+
+// Leading byte of every record
+enum RecordType : uint8_t {
+	kRecordKey = 1,		// float time, int16 key, uint8 action
+	kRecordFrame,		// float deltaTime, uint16 physics steps
+	kRecordEnd			// uint32 frame count, uint64 state hash
+};
+
+InputRecorder::InputRecorder()
+{
+	frameCount = 0;
+}
+
+bool InputRecorder::open(const std::string& filename,
+	const RecordingScene& scene)
+{
+	file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(kRecordingMagic, sizeof(kRecordingMagic));
+	write(kRecordingVersion);
+	write(scene.physicsRate);
+	write(scene.bodyCount);
+	write(scene.meshType);
+	write(scene.lightCount);
+
+	start		= std::chrono::high_resolution_clock::now();
+	frameCount	= 0;
+
+	return true;
+}
+
+void InputRecorder::addKey(int key, int action)
+{
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	float time = std::chrono::duration<float, std::chrono::seconds::period>(
+		std::chrono::high_resolution_clock::now() - start).count();
+
+	write((uint8_t)kRecordKey);
+	write(time);
+	write((int16_t)key);
+	write((uint8_t)action);
+}
+
+void InputRecorder::addFrame(float deltaTime, int physicsSteps)
+{
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	write((uint8_t)kRecordFrame);
+	write(deltaTime);
+	write((uint16_t)physicsSteps);
+
+	frameCount++;
+}
+
+void InputRecorder::close(uint64_t stateHash)
+{
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	write((uint8_t)kRecordEnd);
+	write(frameCount);
+	write(stateHash);
+
+	file.close();
+}
+
+uint64_t InputRecorder::hashState(btDynamicsWorld* world)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	auto add = [&hash](btScalar value)
+	{
+		unsigned char bytes[sizeof(btScalar)];
+		memcpy(bytes, &value, sizeof(value));
+
+		for (unsigned char byte : bytes)
+		{
+			hash = (hash ^ byte) * 1099511628211ull;
+		}
+	};
+
+	btCollisionObjectArray& objects = world->getCollisionObjectArray();
+
+	for (int i = 0; i < world->getNumCollisionObjects(); i++)
+	{
+		const btRigidBody* body = btRigidBody::upcast(objects[i]);
+
+		if (body == NULL)
+		{
+			continue;
+		}
+
+		// Component by component, btVector3 carries an unused fourth float
+		const btTransform& transform	= body->getWorldTransform();
+		const btVector3& origin			= transform.getOrigin();
+		btQuaternion rotation			= transform.getRotation();
+		const btVector3& linear			= body->getLinearVelocity();
+		const btVector3& angular		= body->getAngularVelocity();
+
+		add(origin.x());
+		add(origin.y());
+		add(origin.z());
+		add(rotation.x());
+		add(rotation.y());
+		add(rotation.z());
+		add(rotation.w());
+		add(linear.x());
+		add(linear.y());
+		add(linear.z());
+		add(angular.x());
+		add(angular.y());
+		add(angular.z());
+	}
+
+	return hash;
+}
+
+template <typename T>
+void InputRecorder::write(T value)
+{
+	file.write((const char*)&value, sizeof(value));
+}
+
+// Copies the next value out of data, false past its end
+template <typename T>
+static bool read(const std::vector<char>& data, size_t* offset, T* value)
+{
+	if (*offset + sizeof(T) > data.size())
+	{
+		return false;
+	}
+
+	memcpy(value, &data[*offset], sizeof(T));
+	*offset += sizeof(T);
+
+	return true;
+}
+
+InputPlayer::InputPlayer()
+{
+	scene		= RecordingScene();
+	stateHashed	= false;
+	stateHash	= 0;
+}
+
+bool InputPlayer::open(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::vector<char> data((std::istreambuf_iterator<char>(file)),
+		std::istreambuf_iterator<char>());
+
+	size_t offset = 0;
+	char magic[4];
+	uint32_t version = 0;
+
+	if (!read(data, &offset, &magic) ||
+		memcmp(magic, kRecordingMagic, sizeof(magic)) != 0 ||
+		!read(data, &offset, &version) || version != kRecordingVersion ||
+		!read(data, &offset, &scene.physicsRate) ||
+		!read(data, &offset, &scene.bodyCount) ||
+		!read(data, &offset, &scene.meshType) ||
+		!read(data, &offset, &scene.lightCount))
+	{
+		return false;
+	}
+
+	// The mesh type indexes GeometryRegistry's tables
+	if (scene.meshType < 0 || scene.meshType >= kMeshTypeCount)
+	{
+		return false;
+	}
+
+	// The fixed step is 1 / physicsRate
+	if (!std::isfinite(scene.physicsRate) || scene.physicsRate <= 0.0f)
+	{
+		return false;
+	}
+
+	// Both size allocations before the first frame
+	if (scene.bodyCount < 0 || scene.bodyCount > kMaxRecordedBodies ||
+		scene.lightCount < 0 || scene.lightCount > ClusteredLighting::kMaxLights)
+	{
+		return false;
+	}
+
+	frames.clear();
+	keys.clear();
+	stateHashed = false;
+
+	size_t pendingKeys = 0;	// read since the last frame
+	uint8_t type = 0;
+
+	// A record cut off part way through ends the recording like a missing
+	// end record
+	while (read(data, &offset, &type))
+	{
+		if (type == kRecordKey)
+		{
+			float time		= 0.0f;
+			int16_t key		= 0;
+			uint8_t action	= 0;
+
+			if (!read(data, &offset, &time) || !read(data, &offset, &key) ||
+				!read(data, &offset, &action))
+			{
+				break;
+			}
+
+			keys.push_back(RecordedKey{ time, key, action });
+			pendingKeys++;
+		}
+		else if (type == kRecordFrame)
+		{
+			float deltaTime	= 0.0f;
+			uint16_t steps	= 0;
+
+			if (!read(data, &offset, &deltaTime) ||
+				!read(data, &offset, &steps))
+			{
+				break;
+			}
+
+			frames.push_back(RecordedFrame{ deltaTime, steps,
+				keys.size() - pendingKeys, pendingKeys });
+			pendingKeys = 0;
+		}
+		else if (type == kRecordEnd)
+		{
+			uint32_t frameCount = 0;
+
+			stateHashed = read(data, &offset, &frameCount) &&
+				read(data, &offset, &stateHash) &&
+				frameCount == frames.size();
+			break;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const RecordingScene& InputPlayer::getScene()
+{
+	return scene;
+}
+
+int InputPlayer::getFrameCount()
+{
+	return (int)frames.size();
+}
+
+const RecordedFrame& InputPlayer::getFrame(int index)
+{
+	return frames[index];
+}
+
+const RecordedKey& InputPlayer::getKey(size_t index)
+{
+	return keys[index];
+}
+
+bool InputPlayer::hasStateHash()
+{
+	return stateHashed;
+}
+
+uint64_t InputPlayer::getStateHash()
+{
+	return stateHash;
+}
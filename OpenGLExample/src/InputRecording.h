@@ -0,0 +1,98 @@
+#pragma once
+
+#include "bullet/btBulletDynamicsCommon.h"
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Command line settings that shape the simulation. A recording stores them
+// so it is replayed against the scene it was made in.
+struct RecordingScene
+{
+	float	physicsRate;
+	int32_t	bodyCount;
+	int32_t	meshType;
+	int32_t	lightCount;
+};
+
+// Game key event, time in seconds since the recording started
+struct RecordedKey
+{
+	float	time;
+	int		key;
+	int		action;
+};
+
+// Keys are applied before the frame they are listed with, the way GLFW
+// delivers them during the previous frame's glfwPollEvents
+struct RecordedFrame
+{
+	float	deltaTime;
+	int		physicsSteps;	// fixed steps Bullet actually took
+	size_t	firstKey;
+	size_t	keyCount;
+};
+
+// Writes a binary log of a windowed session: a header with the scene, then
+// one small record per key event and per frame, and finally a hash of every
+// rigid body's state. Frames store the fixed step count rather than only the
+// wall clock delta, so a replay never depends on accumulator rounding.
+// Files are in host byte order.
+class InputRecorder
+{
+public:
+	InputRecorder();
+
+	// Returns false if the file can't be opened
+	bool open(const std::string& filename, const RecordingScene& scene);
+
+	void addKey(int key, int action);
+	void addFrame(float deltaTime, int physicsSteps);
+
+	// Ends the log with the state to compare replays against
+	void close(uint64_t stateHash);
+
+	// FNV-1a over position, rotation and velocities of every rigid body in
+	// world order, equal only for bit identical simulations
+	static uint64_t hashState(btDynamicsWorld* world);
+
+private:
+
+	template <typename T>
+	void write(T value);
+
+	std::ofstream									file;
+	std::chrono::high_resolution_clock::time_point	start;
+	uint32_t										frameCount;
+};
+
+// Reads a whole recording up front so replaying costs nothing per frame
+class InputPlayer
+{
+public:
+	InputPlayer();
+
+	// Returns false if the file can't be read or isn't a recording
+	bool open(const std::string& filename);
+
+	const RecordingScene& getScene();
+	int getFrameCount();
+	const RecordedFrame& getFrame(int index);
+	const RecordedKey& getKey(size_t index);
+
+	// Recordings cut short by a crash end without a hash
+	bool hasStateHash();
+	uint64_t getStateHash();
+
+private:
+
+	RecordingScene				scene;
+	std::vector<RecordedFrame>	frames;
+	std::vector<RecordedKey>	keys;
+	bool						stateHashed;
+	uint64_t					stateHash;
+};
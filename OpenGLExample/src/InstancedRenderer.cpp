@@ -0,0 +1,262 @@
+#include "InstancedRenderer.h"
+
+// std
+#include <cstring>
+
+InstancedRenderer::InstancedRenderer(Camera* inCamera, StreamBuffer* inStream)
+{
+	camera			= inCamera;
+	stream			= inStream;
+	vao				= 0;
+	drawCallCount	= 0;
+	visibleCount	= 0;
+	culledCount		= 0;
+	reportedStreamFull	= false;
+}
+
+InstancedRenderer::~InstancedRenderer()
+{
+	glDeleteVertexArrays(1, &vao);
+
+	for (Batch* batch : batches)
+	{
+		delete batch;
+	}
+}
+
+void InstancedRenderer::submit(RenderQueue* queue, EntityStore* entities)
+{
+	const Frustum& frustum = camera->getFrustum();
+
+	drawCallCount	= 0;
+	visibleCount	= 0;
+	culledCount		= 0;
+
+	for (Batch* batch : batches)
+	{
+		batch->instances.clear();
+		batch->instanceLods.clear();
+		batch->lodCounts.assign(batch->geometry->lods.size(), 0);
+	}
+
+	// One pass over the store, each visible entity lands in its batch
+	for (size_t i = 0; i < entities->getCount(); i++)
+	{
+		int batchIndex = entities->renderBatches[i];
+
+		if (batchIndex < 0)
+		{
+			continue;
+		}
+
+		Batch* batch = batches[batchIndex];
+
+		// Program may still be compiling
+		if (!batch->program->isReady())
+		{
+			continue;
+		}
+
+		const Geometry& geometry = *batch->geometry;
+
+		InstanceData instance;
+		instance.transform	= (GLuint)i;
+		instance.material	= entities->materials[i];
+
+		// The broadphase AABB is tested first, culled bodies never have
+		// their transform built
+		btVector3 aabbMin;
+		btVector3 aabbMax;
+		entities->bodies[i]->getAabb(aabbMin, aabbMax);
+
+		if (!frustum.intersectsAabb(
+			glm::vec3(aabbMin.x(), aabbMin.y(), aabbMin.z()),
+			glm::vec3(aabbMax.x(), aabbMax.y(), aabbMax.z())))
+		{
+			culledCount++;
+			continue;
+		}
+
+		entities->updateTransform(i);
+
+		const glm::vec3& scale = entities->scales[i];
+
+		glm::vec3 center = glm::vec3(entities->transforms[i][3]);
+		float radius = geometry.boundingRadius *
+			glm::max(scale.x, glm::max(scale.y, scale.z));
+
+		int lod = 0;
+
+		if (geometry.lods.size() > 1)
+		{
+			lod = geometry.selectLodIndex(
+				camera->getProjectedSize(center, radius));
+		}
+
+		batch->instances.push_back(instance);
+		batch->instanceLods.push_back(lod);
+		batch->lodCounts[lod]++;
+	}
+
+	for (Batch* batch : batches)
+	{
+		const Geometry& geometry = *batch->geometry;
+
+		visibleCount += (int)batch->instances.size();
+
+		if (batch->instances.empty())
+		{
+			continue;
+		}
+
+		// Aligned to whole instances, so the offset is the first instance
+		// index the attributes read from
+		GLintptr offset;
+		InstanceData* upload = (InstanceData*)stream->allocate(
+			sizeof(InstanceData) * batch->instances.size(),
+			sizeof(InstanceData), &offset);
+
+		if (upload == NULL)
+		{
+			// Once is enough, printing every frame would only slow it further
+			if (!reportedStreamFull)
+			{
+				std::cout << "Stream buffer full, skipping " <<
+					batch->instances.size() << " instances" << '\n';
+				reportedStreamFull = true;
+			}
+
+			continue;
+		}
+
+		if (geometry.lods.size() > 1)
+		{
+			// Counting sort so every level is one contiguous run, written
+			// straight into the stream
+			lodOffsets.assign(geometry.lods.size(), 0);
+
+			for (size_t lod = 1; lod < lodOffsets.size(); lod++)
+			{
+				lodOffsets[lod] = lodOffsets[lod - 1] +
+					batch->lodCounts[lod - 1];
+			}
+
+			for (size_t i = 0; i < batch->instances.size(); i++)
+			{
+				upload[lodOffsets[batch->instanceLods[i]]++] =
+					batch->instances[i];
+			}
+		}
+		else
+		{
+			memcpy(upload, batch->instances.data(),
+				sizeof(InstanceData) * batch->instances.size());
+		}
+
+		GLuint baseInstance = (GLuint)(offset / sizeof(InstanceData));
+
+		for (size_t lod = 0; lod < geometry.lods.size(); lod++)
+		{
+			if (batch->lodCounts[lod] == 0)
+			{
+				continue;
+			}
+
+			DrawPacket packet;
+			packet.program			= batch->program;
+			packet.texture			= batch->texture->id;
+			packet.vao				= vao;
+			packet.count			= geometry.lods[lod].indexCount;
+			packet.first			= geometry.lods[lod].firstIndex;
+			packet.baseVertex		= geometry.lods[lod].baseVertex;
+			packet.indexType		= GeometryRegistry::getIndexType();
+			packet.instanceCount	= (GLsizei)batch->lodCounts[lod];
+			packet.baseInstance		= baseInstance;
+
+			queue->submit(packet);
+
+			baseInstance += batch->lodCounts[lod];
+			drawCallCount++;
+		}
+	}
+}
+
+int InstancedRenderer::getVisibleCount()
+{
+	return visibleCount;
+}
+
+int InstancedRenderer::getCulledCount()
+{
+	return culledCount;
+}
+
+int InstancedRenderer::getBatchCount()
+{
+	return (int)batches.size();
+}
+
+int InstancedRenderer::getDrawCallCount()
+{
+	return drawCallCount;
+}
+
+int InstancedRenderer::getBatch(MeshType meshType, ShaderProgram* program,
+	TextureHandle texture)
+{
+	const Geometry* geometry = GeometryRegistry::get(meshType);
+
+	for (size_t i = 0; i < batches.size(); i++)
+	{
+		if (batches[i]->geometry == geometry && batches[i]->program == program &&
+			batches[i]->texture == texture)
+		{
+			return (int)i;
+		}
+	}
+
+	Batch* batch		= new Batch();
+	batch->geometry		= geometry;
+	batch->program		= program;
+	batch->texture		= texture;
+
+	if (vao == 0)
+	{
+		createVertexArray();
+	}
+
+	batches.push_back(batch);
+
+	return (int)batches.size() - 1;
+}
+
+void InstancedRenderer::createVertexArray()
+{
+	// The VAO reads the shared mesh buffers plus the instances in the stream
+	// buffer, each draw's baseVertex and baseInstance pick out its ranges
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	// InstancedLitTexturedModel.vs
+	GeometryRegistry::setVertexFormat(kFormatLit);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GeometryRegistry::getIndexBuffer());
+
+	glBindBuffer(GL_ARRAY_BUFFER, stream->getBuffer());
+
+	// An integer attribute, read without conversion to float
+	glEnableVertexAttribArray(kAttribInstanceTransform);
+	glVertexAttribIPointer(kAttribInstanceTransform, 1, GL_UNSIGNED_INT,
+		sizeof(InstanceData),
+		(void*)(offsetof(InstanceData, transform)));
+	glVertexAttribDivisor(kAttribInstanceTransform, 1);
+
+	glEnableVertexAttribArray(kAttribInstanceMaterial);
+	glVertexAttribPointer(kAttribInstanceMaterial, 2, GL_FLOAT, GL_FALSE,
+		sizeof(InstanceData),
+		(void*)(offsetof(InstanceData, material)));
+	glVertexAttribDivisor(kAttribInstanceMaterial, 1);
+
+	// unbind
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include "bullet/btBulletDynamicsCommon.h"
+
+#include "Camera.h"
+#include "EntityStore.h"
+#include "GeometryRegistry.h"
+#include "Mesh.h"
+#include "RenderQueue.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+#include "TextureLoader.h"
+
+#include <vector>
+
+// Per-instance vertex data, read by InstancedLitTexturedModel.vs. The
+// matrices themselves are in the TransformBuffer.
+struct InstanceData
+{
+	GLuint		transform;	// entity index into the transform buffer
+	glm::vec2	material;	// x = specular strength, y = ambient strength
+};
+
+// Draws entities that share a mesh, program and texture with one instanced
+// draw per level of detail in use. All batches read through one VAO, so the
+// render queue can merge batches that share a program and texture into a
+// single multi-draw. Each frame one pass over the entity store skips
+// entities whose rigid body AABB is outside the camera frustum, builds the
+// transforms of the rest and sorts them into their batch by the level their
+// screen size selects. Each batch is then written into the frame's range of
+// the stream buffer.
+class InstancedRenderer
+{
+public:
+	InstancedRenderer(Camera* inCamera, StreamBuffer* inStream);
+	~InstancedRenderer();
+
+	// Batch index for EntityStore::renderBatches, created on first use
+	int getBatch(MeshType meshType, ShaderProgram* program,
+		TextureHandle texture);
+
+	// Gathers the visible entities into the stream buffer, then submits one
+	// packet per batch and level of detail. Call between the stream's
+	// beginFrame() and flush(), followed by TransformBuffer::update() in the
+	// same frame so the entity indices match.
+	void submit(RenderQueue* queue, EntityStore* entities);
+
+	int getBatchCount();
+	int getDrawCallCount();	// last frame, packets before the queue merges them
+	int getVisibleCount();	// last frame
+	int getCulledCount();	// last frame
+
+private:
+
+	struct Batch
+	{
+		const Geometry*				geometry;
+		ShaderProgram*				program;
+		TextureHandle				texture;
+		std::vector<InstanceData>	instances;	// visible this frame
+		std::vector<int>			instanceLods;
+		std::vector<GLuint>			lodCounts;
+	};
+
+	void createVertexArray();
+
+	Camera*				camera;
+	StreamBuffer*		stream;
+	GLuint				vao;			// shared meshes plus stream instances
+	std::vector<Batch*> batches;
+	std::vector<GLuint>	lodOffsets;		// counting sort scratch, reused
+	int					drawCallCount;	// last frame
+	int					visibleCount;
+	int					culledCount;
+	bool				reportedStreamFull;
+};
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <gl/glew.h>
+#include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "GeometryRegistry.h"
 #include "Mesh.h"
-#include "ShaderLoader.h"
+#include "RenderQueue.h"
+#include "ShaderProgram.h"
 #include "Camera.h"
 
 class LightRenderer
@@ -14,11 +16,11 @@ public:
 	LightRenderer(MeshType meshType, Camera* inCamera);
 	~LightRenderer();
 
-	void draw();
+	void submit(RenderQueue* queue);
 
 	void setPosition(glm::vec3 inPosition);
 	void setColor(glm::vec3 inColor);
-	void setProgram(GLuint inProgram);
+	void setProgram(ShaderProgram* inProgram);
 
 	glm::vec3 getPosition();
 	glm::vec3 getColor();
@@ -26,12 +28,8 @@ public:
 private:
 
 	Camera*				camera;
-	std::vector<Vertex> vertices;
-	std::vector<GLuint> indices;
+	const Geometry*		geometry;
 	glm::vec3			position;
 	glm::vec3			color;
-	GLuint				vbo;
-	GLuint				ebo;
-	GLuint				vao;
-	GLuint				program;
+	ShaderProgram*		program;
 };
\ No newline at end of file
@@ -1,146 +1,226 @@
 #include "Mesh.h"
 
-void Mesh::setTriData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
-{
-	std::vector<Vertex> newVerticies = {
+#include "SphereNormals.h"
+
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+static const float kPi = 3.14159265f;
 
+// Fixed primitives, built by the compiler so nothing is generated or
+// copied at run time
+static constexpr TableVertex triVertices[] = {
 	{ { 0.0f, -1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0, 1.0 } },
 	{ { 1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 1.0f, 0.0 },{ 0.0, 0.0 } },
 	{ { -1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },
-	};
-
+};
+
+static constexpr uint32_t triIndices[] = {
+	0, 1, 2,
+};
+
+static constexpr TableVertex quadVertices[] = {
+	{ { -1.0f, -1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0, 1.0 } },
+	{ { -1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 1.0f, 0.0 },{ 0.0, 0.0 } },
+	{ { 1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },
+	{ { 1.0f, -1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }
+};
+
+static constexpr uint32_t quadIndices[] = {
+	0, 1, 2,
+	0, 2, 3
+};
+
+static constexpr TableVertex cubeVertices[] = {
+	//front
+	{ { -1.0f, -1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0, 1.0 } },
+	{ { -1.0f, 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 1.0f, 0.0 },{ 0.0, 0.0 } },
+	{ { 1.0f, 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },
+	{ { 1.0f, -1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } },
+
+	// back
+	{ { 1.0, -1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 1.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //4
+	{ { 1.0f, 1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 0.0f, 1.0f, 1.0 },{ 0.0, 0.0 } }, //5
+	{ { -1.0, 1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 0.0f, 1.0f, 1.0 },{ 1.0, 0.0 } }, //6
+	{ { -1.0, -1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //7
+
+
+	//left
+	{ { -1.0, -1.0, -1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //8
+	{ { -1.0f, 1.0, -1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //9
+	{ { -1.0, 1.0, 1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },   //10
+	{ { -1.0, -1.0, 1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //11
+
+	//right
+	{ { 1.0, -1.0, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, // 12
+	{ { 1.0f, 1.0, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //13
+	{ { 1.0, 1.0, -1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } }, //14
+	{ { 1.0, -1.0, -1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //15
+
+	//top
+	{ { -1.0f, 1.0f, 1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //16
+	{ { -1.0f, 1.0f, -1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //17
+	{ { 1.0f, 1.0f, -1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } }, //18
+	{ { 1.0f, 1.0f, 1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //19
+
+	//bottom
+	{ { -1.0f, -1.0, -1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //20
+	{ { -1.0, -1.0, 1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //21
+	{ { 1.0, -1.0, 1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },  //22
+	{ { 1.0, -1.0, -1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //23
+};
+
+static constexpr uint32_t cubeIndices[] = {
+	0, 1, 2,
+	2, 3, 0,
+
+	4, 5, 6,
+	4, 6, 7,
+
+	8, 9, 10,
+	8, 10, 11,
+
+	12, 13, 14,
+	12, 14, 15,
+
+	16, 17, 18,
+	16, 18, 19,
+
+	20, 21, 22,
+	20, 22, 23
+};
+
+// The default sphere, same layout as setSphereData(kSphereBands, kSphereBands)
+static constexpr int kSphereVertexCount	= (kSphereBands + 1) * (kSphereBands + 1);
+static constexpr int kSphereIndexCount	= kSphereBands * kSphereBands * 6;
+
+static_assert(std::size(kSphereNormals) == kSphereVertexCount,
+	"SphereNormals.h was generated for a different kSphereBands");
+
+static constexpr TableVertex makeSphereVertex(int index)
+{
+	int latNumber	= index / (kSphereBands + 1);
+	int longNumber	= index % (kSphereBands + 1);
 
-	std::vector<uint32_t> newIndices = {
-		0, 1, 2,
-	};
+	// Unit radius, so the position and the colour are the normal
+	float x = kSphereNormals[index][0];
+	float y = kSphereNormals[index][1];
+	float z = kSphereNormals[index][2];
 
-	vertices.clear(); 
-	indices.clear();
-
-	vertices = newVerticies;
-	indices	 = newIndices;
+	return TableVertex{ { x, y, z }, { x, y, z }, { x, y, z },
+		{ (float)longNumber / kSphereBands, (float)latNumber / kSphereBands } };
 }
 
-void Mesh::setQuadData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+// Built by pack expansion, one makeSphereVertex() call per element
+template <size_t... I>
+static constexpr std::array<TableVertex, sizeof...(I)> makeSphereVertices(
+	std::index_sequence<I...>)
 {
-	std::vector<Vertex> newVerticies = {
-
-		{ { -1.0f, -1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0, 1.0 } },
-		{ { -1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 1.0f, 0.0 },{ 0.0, 0.0 } },
-		{ { 1.0f, 1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },
-		{ { 1.0f, -1.0f, 0.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }
-	};
+	return { { makeSphereVertex((int)I)... } };
+}
 
+static constexpr std::array<uint32_t, kSphereIndexCount> makeSphereIndices()
+{
+	std::array<uint32_t, kSphereIndexCount> newIndices = {};
+	int i = 0;
+
+	for (uint32_t latNumber = 0; latNumber < kSphereBands; latNumber++)
+	{
+		for (uint32_t longNumber = 0; longNumber < kSphereBands; longNumber++)
+		{
+			uint32_t first	= (latNumber * (kSphereBands + 1)) + longNumber;
+			uint32_t second	= first + kSphereBands + 1;
+
+			newIndices[i++] = first;
+			newIndices[i++] = second;
+			newIndices[i++] = first + 1;
+
+			newIndices[i++] = second;
+			newIndices[i++] = second + 1;
+			newIndices[i++] = first + 1;
+		}
+	}
 
-	std::vector<uint32_t> newIndices = {
+	return newIndices;
+}
 
-		0, 1, 2,
-		0, 2, 3
-	};
+static constexpr std::array<TableVertex, kSphereVertexCount> sphereVertices =
+	makeSphereVertices(std::make_index_sequence<kSphereVertexCount>());
 
-	vertices.clear(); 
-	indices.clear();
+static constexpr std::array<uint32_t, kSphereIndexCount> sphereIndices =
+	makeSphereIndices();
 
-	vertices = newVerticies;
-	indices  = newIndices;
+MeshData Mesh::getTriData()
+{
+	return MeshData{ { triVertices, std::size(triVertices) },
+		{ triIndices, std::size(triIndices) } };
 }
 
-void Mesh::setCubeData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+MeshData Mesh::getQuadData()
 {
-	std::vector<Vertex> newVerticies = {
-
-		//front
-		{ { -1.0f, -1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0, 1.0 } },
-		{ { -1.0f, 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 1.0f, 0.0 },{ 0.0, 0.0 } },
-		{ { 1.0f, 1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },
-		{ { 1.0f, -1.0f, 1.0f },{ 0.0f, 0.0f, 1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } },
-
-		// back 
-		{ { 1.0, -1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 1.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //4
-		{ { 1.0f, 1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 0.0f, 1.0f, 1.0 },{ 0.0, 0.0 } }, //5
-		{ { -1.0, 1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 0.0f, 1.0f, 1.0 },{ 1.0, 0.0 } }, //6
-		{ { -1.0, -1.0, -1.0 },{ 0.0f, 0.0f, -1.0 },{ 1.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //7
-
-
-		//left
-		{ { -1.0, -1.0, -1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //8
-		{ { -1.0f, 1.0, -1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //9
-		{ { -1.0, 1.0, 1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },   //10
-		{ { -1.0, -1.0, 1.0 },{ -1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //11
-
-		//right
-		{ { 1.0, -1.0, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, // 12
-		{ { 1.0f, 1.0, 1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //13
-		{ { 1.0, 1.0, -1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } }, //14
-		{ { 1.0, -1.0, -1.0 },{ 1.0f, 0.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //15
-
-		//top
-		{ { -1.0f, 1.0f, 1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //16
-		{ { -1.0f, 1.0f, -1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //17
-		{ { 1.0f, 1.0f, -1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } }, //18
-		{ { 1.0f, 1.0f, 1.0f },{ 0.0f, 1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //19
-
-		//bottom 
-		{ { -1.0f, -1.0, -1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 1.0 } }, //20
-		{ { -1.0, -1.0, 1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 0.0, 0.0 } }, //21
-		{ { 1.0, -1.0, 1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 0.0 } },  //22
-		{ { 1.0, -1.0, -1.0 },{ 0.0f, -1.0f, 0.0 },{ 0.0f, 0.0f, 1.0 },{ 1.0, 1.0 } }, //23
-
-	};
-
-	std::vector<uint32_t> newIndices = {
-
-		0, 1, 2,
-		2, 3, 0,
-
-		4, 5, 6,
-		4, 6, 7,
+	return MeshData{ { quadVertices, std::size(quadVertices) },
+		{ quadIndices, std::size(quadIndices) } };
+}
 
-		8, 9, 10,
-		8, 10, 11,
+MeshData Mesh::getCubeData()
+{
+	return MeshData{ { cubeVertices, std::size(cubeVertices) },
+		{ cubeIndices, std::size(cubeIndices) } };
+}
 
-		12, 13, 14,
-		12, 14, 15,
+MeshData Mesh::getSphereData()
+{
+	return MeshData{ { sphereVertices.data(), sphereVertices.size() },
+		{ sphereIndices.data(), sphereIndices.size() } };
+}
 
-		16, 17, 18,
-		16, 18, 19,
+void Mesh::setTableData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+	const MeshData& table)
+{
+	vertices.clear();
+	vertices.reserve(table.vertices.size);
 
-		20, 21, 22,
-		20, 22, 23
+	for (const TableVertex& tv : table.vertices)
+	{
+		Vertex vs;
 
-	};
+		vs.pos			= glm::vec3(tv.pos[0], tv.pos[1], tv.pos[2]);
+		vs.normal		= glm::vec3(tv.normal[0], tv.normal[1], tv.normal[2]);
+		vs.color		= glm::vec3(tv.color[0], tv.color[1], tv.color[2]);
+		vs.texCoords	= glm::vec2(tv.texCoords[0], tv.texCoords[1]);
 
+		vertices.push_back(vs);
+	}
 
-	vertices.clear(); 
-	indices.clear();
-	vertices = newVerticies;
-	indices  = newIndices;
+	indices.assign(table.indices.begin(), table.indices.end());
 }
 
-void Mesh::setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+void Mesh::setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+	int latitudeBands, int longitudeBands)
 {
 	std::vector<Vertex>	  newVertices;
 	std::vector<uint32_t> newIndices;
 
-	float latitudeBands		= 20.0f;
-	float longitudeBands	= 20.0f;
-	float radius			= 1.0f;
+	float radius = 1.0f;
 
-	for (float latNumber = 0; latNumber <= latitudeBands; latNumber++) {
-		float theta = latNumber * 3.14 / latitudeBands;
+	for (int latNumber = 0; latNumber <= latitudeBands; latNumber++) {
+		float theta = latNumber * kPi / latitudeBands;
 		float sinTheta = sin(theta);
 		float cosTheta = cos(theta);
 
-		for (float longNumber = 0; longNumber <= longitudeBands; longNumber++) {
+		for (int longNumber = 0; longNumber <= longitudeBands; longNumber++) {
 
-			float phi = longNumber * 2 * 3.147 / longitudeBands;
+			float phi = longNumber * 2 * kPi / longitudeBands;
 			float sinPhi = sin(phi);
 			float cosPhi = cos(phi);
 
 			Vertex vs;
 
-			vs.texCoords.x = (longNumber / longitudeBands); // u
-			vs.texCoords.y = (latNumber / latitudeBands);   // v
+			vs.texCoords.x = ((float)longNumber / longitudeBands); // u
+			vs.texCoords.y = ((float)latNumber / latitudeBands);   // v
 
 			vs.normal.x = cosPhi * sinTheta;   // normal x
 			vs.normal.y = cosTheta;            // normal y
@@ -158,8 +238,8 @@ void Mesh::setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& i
 		}
 	}
 
-	for (uint32_t latNumber = 0; latNumber < latitudeBands; latNumber++) {
-		for (uint32_t longNumber = 0; longNumber < longitudeBands; longNumber++) {
+	for (uint32_t latNumber = 0; latNumber < (uint32_t)latitudeBands; latNumber++) {
+		for (uint32_t longNumber = 0; longNumber < (uint32_t)longitudeBands; longNumber++) {
 			uint32_t first = (latNumber * (longitudeBands + 1)) + longNumber;
 			uint32_t second = first + longitudeBands + 1;
 
@@ -177,6 +257,109 @@ void Mesh::setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& i
 	vertices.clear(); 
 	indices.clear();
 
+	vertices	= newVertices;
+	indices		= newIndices;
+}
+
+void Mesh::setIcosphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+	int subdivisions)
+{
+	// Golden ratio rectangles, normalised onto the unit sphere below
+	const float t = (1.0f + sqrt(5.0f)) / 2.0f;
+
+	std::vector<glm::vec3> positions = {
+		{ -1.0f, t, 0.0f }, { 1.0f, t, 0.0f }, { -1.0f, -t, 0.0f }, { 1.0f, -t, 0.0f },
+		{ 0.0f, -1.0f, t }, { 0.0f, 1.0f, t }, { 0.0f, -1.0f, -t }, { 0.0f, 1.0f, -t },
+		{ t, 0.0f, -1.0f }, { t, 0.0f, 1.0f }, { -t, 0.0f, -1.0f }, { -t, 0.0f, 1.0f }
+	};
+
+	std::vector<uint32_t> newIndices = {
+		0, 11, 5,	0, 5, 1,	0, 1, 7,	0, 7, 10,	0, 10, 11,
+		1, 5, 9,	5, 11, 4,	11, 10, 2,	10, 7, 6,	7, 1, 8,
+		3, 9, 4,	3, 4, 2,	3, 2, 6,	3, 6, 8,	3, 8, 9,
+		4, 9, 5,	2, 4, 11,	6, 2, 10,	8, 6, 7,	9, 8, 1
+	};
+
+	for (glm::vec3& position : positions)
+	{
+		position = glm::normalize(position);
+	}
+
+	for (int level = 0; level < subdivisions; level++)
+	{
+		// Shared edges get one midpoint, keyed by both end indices
+		std::unordered_map<uint64_t, uint32_t> midpoints;
+
+		auto getMidpoint = [&](uint32_t a, uint32_t b)
+		{
+			uint64_t key = a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+
+			auto found = midpoints.find(key);
+
+			if (found != midpoints.end())
+			{
+				return found->second;
+			}
+
+			uint32_t index = (uint32_t)positions.size();
+			positions.push_back(glm::normalize(positions[a] + positions[b]));
+			midpoints[key] = index;
+
+			return index;
+		};
+
+		std::vector<uint32_t> subdivided;
+		subdivided.reserve(newIndices.size() * 4);
+
+		for (size_t i = 0; i < newIndices.size(); i += 3)
+		{
+			uint32_t a = newIndices[i];
+			uint32_t b = newIndices[i + 1];
+			uint32_t c = newIndices[i + 2];
+
+			uint32_t ab = getMidpoint(a, b);
+			uint32_t bc = getMidpoint(b, c);
+			uint32_t ca = getMidpoint(c, a);
+
+			subdivided.insert(subdivided.end(), {
+				a, ab, ca,
+				b, bc, ab,
+				c, ca, bc,
+				ab, bc, ca });
+		}
+
+		newIndices.swap(subdivided);
+	}
+
+	// Wind the triangles the same way as setSphereData
+	for (size_t i = 0; i < newIndices.size(); i += 3)
+	{
+		std::swap(newIndices[i + 1], newIndices[i + 2]);
+	}
+
+	std::vector<Vertex> newVertices;
+	newVertices.reserve(positions.size());
+
+	for (const glm::vec3& position : positions)
+	{
+		Vertex vs;
+
+		vs.pos		= position;
+		vs.normal	= position;
+		vs.color	= position;
+
+		// Same mapping as setSphereData, u around the y axis and v from the top
+		float phi = atan2(position.z, position.x);
+
+		vs.texCoords.x = (phi < 0.0f ? phi + 2 * kPi : phi) / (2 * kPi);
+		vs.texCoords.y = acos(glm::clamp(position.y, -1.0f, 1.0f)) / kPi;
+
+		newVertices.push_back(vs);
+	}
+
+	vertices.clear();
+	indices.clear();
+
 	vertices	= newVertices;
 	indices		= newIndices;
 }
\ No newline at end of file
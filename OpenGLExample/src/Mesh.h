@@ -2,13 +2,17 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 enum MeshType {
 	kTriangle = 0,
 	kQuad = 1,
 	kCube = 2,
-	kSphere = 3
+	kSphere = 3,
+	kIcosphere = 4,
+	kMeshTypeCount
 };
 
 struct Vertex {
@@ -18,10 +22,55 @@ struct Vertex {
 	glm::vec2 texCoords;
 };
 
+// Vertex as plain floats, so the fixed tables can be constexpr without
+// depending on glm's constructors being constexpr. Turned into Vertex by
+// Mesh::setTableData() when the tables are uploaded.
+struct TableVertex {
+	float pos[3];
+	float normal[3];
+	float color[3];
+	float texCoords[2];
+};
+
+// Read-only view of a contiguous array, std::span only arrives in C++20
+template <typename T>
+struct Span
+{
+	const T*	data;
+	size_t		size;
+
+	const T* begin() const { return data; }
+	const T* end() const { return data + size; }
+};
+
+struct MeshData
+{
+	Span<TableVertex>	vertices;
+	Span<uint32_t>		indices;
+};
+
+// Bands of the sphere getSphereData() returns
+const int kSphereBands = 20;
+
 class Mesh {
 public:
-	static void setTriData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
-	static void setQuadData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
-	static void setCubeData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
-	static void setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+	// Fixed primitives and the default sphere live in constexpr tables, these
+	// only point at them
+	static MeshData getTriData();
+	static MeshData getQuadData();
+	static MeshData getCubeData();
+	static MeshData getSphereData();
+
+	// Replaces vertices and indices with a copy of a table
+	static void setTableData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+		const MeshData& table);
+
+	// Other tessellations are generated at run time
+	static void setSphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+		int latitudeBands, int longitudeBands);
+
+	// Icosahedron with each triangle split into four per subdivision, 20 * 4^n
+	// triangles spread evenly over the sphere
+	static void setIcosphereData(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+		int subdivisions);
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "PhysicsTaskScheduler.h"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler(int threadCount)
+	: btITaskScheduler("ThreadPool")
+{
+	// Bullet numbers threads in the order they first ask, the main thread has
+	// to be index 0 before any worker asks
+	btGetCurrentThreadIndex();
+
+	workers = NULL;
+	setNumThreads(threadCount);
+}
+
+PhysicsTaskScheduler::~PhysicsTaskScheduler()
+{
+	delete workers;
+}
+
+int PhysicsTaskScheduler::getMaxNumThreads() const
+{
+	return BT_MAX_THREAD_COUNT;
+}
+
+int PhysicsTaskScheduler::getNumThreads() const
+{
+	return threadCount;
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads)
+{
+	threadCount = std::max(1, std::min(numThreads, getMaxNumThreads()));
+
+	// Joins the old workers, nothing is running between steps
+	delete workers;
+	workers = new ThreadPool(threadCount - 1);
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize,
+	const btIParallelForBody& body)
+{
+	run(iBegin, iEnd, grainSize, [&body](int begin, int end)
+	{
+		body.forLoop(begin, end);
+	});
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize,
+	const btIParallelSumBody& body)
+{
+	grainSize = std::max(1, grainSize);
+
+	// One slot per chunk, added up in order so the result does not depend on
+	// which thread finished first
+	std::vector<btScalar> sums((iEnd - iBegin + grainSize - 1) / grainSize, 0);
+
+	run(iBegin, iEnd, grainSize, [&](int begin, int end)
+	{
+		sums[(begin - iBegin) / grainSize] = body.sumLoop(begin, end);
+	});
+
+	btScalar sum = 0;
+
+	for (btScalar chunkSum : sums)
+	{
+		sum += chunkSum;
+	}
+
+	return sum;
+}
+
+void PhysicsTaskScheduler::run(int iBegin, int iEnd, int grainSize,
+	const std::function<void(int, int)>& job)
+{
+	if (iEnd <= iBegin)
+	{
+		return;
+	}
+
+	grainSize = std::max(1, grainSize);
+
+	int chunkCount = (iEnd - iBegin + grainSize - 1) / grainSize;
+
+	// Small loops are not worth waking anyone
+	if (chunkCount == 1 || threadCount == 1)
+	{
+		for (int begin = iBegin; begin < iEnd; begin += grainSize)
+		{
+			job(begin, std::min(begin + grainSize, iEnd));
+		}
+
+		return;
+	}
+
+	std::atomic<int> nextChunk(0);
+
+	auto work = [&]()
+	{
+		int chunk;
+
+		while ((chunk = nextChunk++) < chunkCount)
+		{
+			int begin = iBegin + chunk * grainSize;
+			job(begin, std::min(begin + grainSize, iEnd));
+		}
+	};
+
+	int helperCount = std::min(threadCount - 1, chunkCount - 1);
+	int running		= helperCount;
+
+	for (int i = 0; i < helperCount; i++)
+	{
+		workers->enqueue([&]()
+		{
+			work();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			running--;
+
+			if (running == 0)
+			{
+				finished.notify_one();
+			}
+		});
+	}
+
+	work();
+
+	// The helpers reference this stack frame, wait for every one of them
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [&running] { return running == 0; });
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "bullet/LinearMath/btThreads.h"
+
+#include "ThreadPool.h"
+
+// std
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+// Runs Bullet's parallel loops on a ThreadPool of its own, kept apart from the
+// texture decoders so a burst of loads never delays a physics step. The
+// calling thread works through the loop as well, so N threads means N - 1
+// pool workers. Install with btSetTaskScheduler() before building a
+// btDiscreteDynamicsWorldMt.
+class PhysicsTaskScheduler : public btITaskScheduler
+{
+public:
+	PhysicsTaskScheduler(int threadCount);
+	~PhysicsTaskScheduler();
+
+	int getMaxNumThreads() const override;
+	int getNumThreads() const override;
+	void setNumThreads(int numThreads) override;
+
+	void parallelFor(int iBegin, int iEnd, int grainSize,
+		const btIParallelForBody& body) override;
+	btScalar parallelSum(int iBegin, int iEnd, int grainSize,
+		const btIParallelSumBody& body) override;
+
+private:
+
+	// Hands out [iBegin, iEnd) in grainSize chunks to the workers and the
+	// calling thread, returns once every chunk has run
+	void run(int iBegin, int iEnd, int grainSize,
+		const std::function<void(int, int)>& job);
+
+	ThreadPool*				workers;
+	int						threadCount;	// including the calling thread
+	std::mutex				mutex;
+	std::condition_variable	finished;
+};
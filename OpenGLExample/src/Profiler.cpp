@@ -0,0 +1,264 @@
+#include "Profiler.h"
+
+// std
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+Profiler::Profiler()
+{
+	for (History& history : histories)
+	{
+		history.next	= 0;
+		history.count	= 0;
+		history.total	= 0;
+	}
+
+	gpuSupported	= GLEW_ARB_timer_query;
+	gpuActive		= false;
+	queryIndex		= 0;
+
+	for (int i = 0; i < kGpuQueryCount; i++)
+	{
+		queryPending[i] = false;
+	}
+
+	if (gpuSupported)
+	{
+		glGenQueries(kGpuQueryCount, queries);
+	}
+}
+
+Profiler::~Profiler()
+{
+	if (gpuSupported)
+	{
+		glDeleteQueries(kGpuQueryCount, queries);
+	}
+}
+
+void Profiler::beginFrame()
+{
+	begin(kProfileFrame);
+}
+
+void Profiler::endFrame()
+{
+	end(kProfileFrame);
+}
+
+void Profiler::begin(ProfileStage stage)
+{
+	starts[stage] = std::chrono::high_resolution_clock::now();
+}
+
+void Profiler::end(ProfileStage stage)
+{
+	record(stage, std::chrono::duration<float, std::chrono::milliseconds::period>(
+		std::chrono::high_resolution_clock::now() - starts[stage]).count());
+}
+
+void Profiler::beginGpu()
+{
+	gpuActive = false;
+
+	if (!gpuSupported)
+	{
+		return;
+	}
+
+	GLuint query = queries[queryIndex];
+
+	// The slot's previous frame has had kGpuQueryCount - 1 frames to finish
+	if (queryPending[queryIndex])
+	{
+		GLint available = 0;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+
+		// Rather drop this frame's sample than wait for the GPU
+		if (!available)
+		{
+			return;
+		}
+
+		GLuint64 nanoseconds = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &nanoseconds);
+
+		record(kProfileGpu, nanoseconds / 1000000.0f);
+		queryPending[queryIndex] = false;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, query);
+	gpuActive = true;
+}
+
+void Profiler::endGpu()
+{
+	if (!gpuActive)
+	{
+		return;
+	}
+
+	glEndQuery(GL_TIME_ELAPSED);
+
+	queryPending[queryIndex]	= true;
+	queryIndex					= (queryIndex + 1) % kGpuQueryCount;
+	gpuActive					= false;
+}
+
+ProfileStats Profiler::getStats(ProfileStage stage)
+{
+	ProfileStats stats = {};
+
+	std::vector<float> samples = getSamples(stage);
+
+	if (samples.empty())
+	{
+		return stats;
+	}
+
+	stats.last	= samples.back();
+	stats.count	= (int)samples.size();
+
+	std::sort(samples.begin(), samples.end());
+
+	float total = 0.0f;
+
+	for (float sample : samples)
+	{
+		total += sample;
+	}
+
+	stats.min		= samples.front();
+	stats.average	= total / samples.size();
+	stats.p99		= samples[(samples.size() - 1) * 99 / 100];
+
+	return stats;
+}
+
+float Profiler::getLast(ProfileStage stage)
+{
+	const History& history = histories[stage];
+
+	if (history.count == 0)
+	{
+		return 0.0f;
+	}
+
+	return history.samples[(history.next - 1 + kProfileWindow) % kProfileWindow];
+}
+
+int Profiler::getSampleTotal(ProfileStage stage)
+{
+	return histories[stage].total;
+}
+
+std::string Profiler::getReport()
+{
+	std::string report;
+	char line[96];
+
+	for (int stage = 0; stage < kProfileStageCount; stage++)
+	{
+		ProfileStats stats = getStats((ProfileStage)stage);
+
+		if (stats.count == 0)
+		{
+			continue;
+		}
+
+		snprintf(line, sizeof(line), "%s: %.2f / %.2f / %.2f ms\n",
+			getStageName((ProfileStage)stage), stats.min, stats.average,
+			stats.p99);
+
+		report += line;
+	}
+
+	return report;
+}
+
+bool Profiler::dump(const std::string& filename)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::trunc);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file << "stage,min_ms,avg_ms,p99_ms,samples" << '\n';
+
+	for (int stage = 0; stage < kProfileStageCount; stage++)
+	{
+		ProfileStats stats = getStats((ProfileStage)stage);
+
+		file << getStageName((ProfileStage)stage) << ',' << stats.min << ',' <<
+			stats.average << ',' << stats.p99 << ',' << stats.count << '\n';
+	}
+
+	// Raw samples, oldest first, one row per stage
+	file << '\n' << "stage,samples_ms" << '\n';
+
+	for (int stage = 0; stage < kProfileStageCount; stage++)
+	{
+		file << getStageName((ProfileStage)stage);
+
+		for (float sample : getSamples((ProfileStage)stage))
+		{
+			file << ',' << sample;
+		}
+
+		file << '\n';
+	}
+
+	return true;
+}
+
+const char* Profiler::getStageName(ProfileStage stage)
+{
+	static const char* names[kProfileStageCount] = {
+		"frame", "loaders", "physics", "render", "swap", "gpu"
+	};
+
+	return names[stage];
+}
+
+void Profiler::record(ProfileStage stage, float milliseconds)
+{
+	History& history = histories[stage];
+
+	history.samples[history.next] = milliseconds;
+	history.next	= (history.next + 1) % kProfileWindow;
+	history.count	= std::min(history.count + 1, kProfileWindow);
+	history.total++;
+}
+
+std::vector<float> Profiler::getSamples(ProfileStage stage)
+{
+	const History& history = histories[stage];
+
+	std::vector<float> samples(history.count);
+
+	// The oldest sample sits at next once the window has wrapped
+	int first = (history.next - history.count + kProfileWindow) % kProfileWindow;
+
+	for (int i = 0; i < history.count; i++)
+	{
+		samples[i] = history.samples[(first + i) % kProfileWindow];
+	}
+
+	return samples;
+}
+
+ProfileScope::ProfileScope(Profiler* inProfiler, ProfileStage inStage)
+{
+	profiler	= inProfiler;
+	stage		= inStage;
+
+	profiler->begin(stage);
+}
+
+ProfileScope::~ProfileScope()
+{
+	profiler->end(stage);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// std
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Stages of a frame that are timed. kProfileGpu is measured with a timer
+// query around renderScene, the rest on the CPU.
+enum ProfileStage {
+	kProfileFrame = 0,
+	kProfileLoaders,
+	kProfilePhysics,
+	kProfileRender,
+	kProfileSwap,
+	kProfileGpu,
+	kProfileStageCount
+};
+
+// Milliseconds over the samples currently in the window
+struct ProfileStats
+{
+	float	min;
+	float	average;
+	float	p99;
+	float	last;
+	int		count;
+};
+
+// Keeps the last kProfileWindow samples of every stage. GPU times are read
+// back from a ring of timer queries only once the driver reports them
+// available, a few frames late, so profiling never stalls the pipeline.
+class Profiler
+{
+public:
+	Profiler();
+	~Profiler();
+
+	// Brackets the whole frame, kProfileFrame covers everything between
+	void beginFrame();
+	void endFrame();
+
+	void begin(ProfileStage stage);
+	void end(ProfileStage stage);
+
+	// Timer query around the GL commands between the two calls, skipped when
+	// GL_ARB_timer_query is missing or the query slot is still in flight
+	void beginGpu();
+	void endGpu();
+
+	ProfileStats getStats(ProfileStage stage);
+
+	// Newest sample and how many were ever recorded, for callers keeping a
+	// longer history than the window
+	float getLast(ProfileStage stage);
+	int getSampleTotal(ProfileStage stage);
+
+	// One line per stage with samples, "name: min / avg / p99 ms"
+	std::string getReport();
+
+	// Writes the summary and every sample in the window, returns false if
+	// the file can't be opened
+	bool dump(const std::string& filename);
+
+	static const char* getStageName(ProfileStage stage);
+
+private:
+
+	static const int kProfileWindow	= 240;	// frames
+	static const int kGpuQueryCount	= 4;	// frames of latency allowed
+
+	struct History
+	{
+		float	samples[kProfileWindow];
+		int		next;
+		int		count;
+		int		total;
+	};
+
+	void record(ProfileStage stage, float milliseconds);
+
+	// Oldest first
+	std::vector<float> getSamples(ProfileStage stage);
+
+	History	histories[kProfileStageCount];
+	std::chrono::high_resolution_clock::time_point starts[kProfileStageCount];
+
+	bool	gpuSupported;
+	bool	gpuActive;		// a query was begun this frame
+	GLuint	queries[kGpuQueryCount];
+	bool	queryPending[kGpuQueryCount];
+	int		queryIndex;
+};
+
+// Times the enclosing block as one stage
+class ProfileScope
+{
+public:
+	ProfileScope(Profiler* inProfiler, ProfileStage inStage);
+	~ProfileScope();
+
+private:
+	Profiler*		profiler;
+	ProfileStage	stage;
+};
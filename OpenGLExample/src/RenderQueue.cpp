@@ -0,0 +1,336 @@
+#include "RenderQueue.h"
+
+static const uint64_t kDepthMask	= (1ull << 24) - 1;
+static const uint64_t kIdMask		= (1ull << 12) - 1;
+
+DrawPacket::DrawPacket()
+{
+	pass			= kPassOpaque;
+	depth			= 0.0f;
+	program			= NULL;
+	texture			= 0;
+	vao				= 0;
+	type			= kDrawElements;
+	count			= 0;
+	first			= 0;
+	baseVertex		= 0;
+	indexType		= GL_UNSIGNED_INT;
+	instanceCount	= 1;
+	baseInstance	= 0;
+	hasModel		= false;
+	model			= glm::mat4(1.0f);
+	hasMaterial		= false;
+	material		= glm::vec2(0.0f);
+	hasColor		= false;
+	color			= glm::vec3(0.0f);
+}
+
+RenderQueue::RenderQueue(Camera* inCamera, StreamBuffer* inStream)
+{
+	camera				= inCamera;
+	stream				= inStream;
+	multiDraw			= GLEW_ARB_multi_draw_indirect;
+	packetCount			= 0;
+	drawCallCount		= 0;
+	bindCount			= 0;
+	skippedBindCount	= 0;
+}
+
+RenderQueue::~RenderQueue()
+{
+}
+
+void RenderQueue::submit(const DrawPacket& packet)
+{
+	packets.push_back(packet);
+}
+
+void RenderQueue::execute()
+{
+	// Sort small key/index pairs rather than whole packets
+	entries.resize(packets.size());
+
+	for (uint32_t i = 0; i < (uint32_t)packets.size(); i++)
+	{
+		entries[i].key		= makeKey(packets[i], i);
+		entries[i].index	= i;
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+
+	// Every run's commands are written before the one flush
+	buildRuns();
+	stream->flush();
+
+	drawCallCount		= 0;
+	bindCount			= 0;
+	skippedBindCount	= 0;
+
+	if (multiDraw)
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, stream->getBuffer());
+	}
+
+	ShaderProgram*	currentProgram	= NULL;
+	GLuint			currentTexture	= 0;
+	GLuint			currentVAO		= 0;
+	bool			textureBound	= false;
+	bool			vaoBound		= false;
+	bool			blending		= false;
+
+	for (size_t i = 0; i < entries.size(); i += entries[i].runLength)
+	{
+		const SortEntry& entry = entries[i];
+		const DrawPacket& packet = packets[entry.index];
+
+		if (packet.pass != kPassOpaque && !blending)
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			blending = true;
+		}
+
+		if (packet.program != currentProgram)
+		{
+			packet.program->use();
+			currentProgram = packet.program;
+			bindCount++;
+		}
+		else
+		{
+			skippedBindCount++;
+		}
+
+		if (!textureBound || packet.texture != currentTexture)
+		{
+			glBindTexture(GL_TEXTURE_2D, packet.texture);
+			currentTexture = packet.texture;
+			textureBound = true;
+			bindCount++;
+		}
+		else
+		{
+			skippedBindCount++;
+		}
+
+		if (!vaoBound || packet.vao != currentVAO)
+		{
+			glBindVertexArray(packet.vao);
+			currentVAO = packet.vao;
+			vaoBound = true;
+			bindCount++;
+		}
+		else
+		{
+			skippedBindCount++;
+		}
+
+		if (entry.runLength > 1)
+		{
+			glMultiDrawElementsIndirect(GL_TRIANGLES, packet.indexType,
+				(void*)entry.commands, (GLsizei)entry.runLength, 0);
+
+			// Each merged packet would have found its state bound
+			skippedBindCount += 3 * (entry.runLength - 1);
+		}
+		else
+		{
+			draw(packet);
+		}
+
+		drawCallCount++;
+	}
+
+	// unbind
+	if (multiDraw)
+	{
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glUseProgram(0);
+
+	if (blending)
+	{
+		glDisable(GL_BLEND);
+	}
+
+	packetCount = (int)packets.size();
+	packets.clear();
+}
+
+int RenderQueue::getPacketCount()
+{
+	return packetCount;
+}
+
+int RenderQueue::getDrawCallCount()
+{
+	return drawCallCount;
+}
+
+int RenderQueue::getBindCount()
+{
+	return bindCount;
+}
+
+int RenderQueue::getSkippedBindCount()
+{
+	return skippedBindCount;
+}
+
+uint64_t RenderQueue::makeKey(const DrawPacket& packet, uint32_t order)
+{
+	// GL names are small integers, the low bits are enough to group by them
+	uint64_t program	= packet.program->getID() & kIdMask;
+	uint64_t texture	= packet.texture & kIdMask;
+	uint64_t vao		= packet.vao & kIdMask;
+
+	float normalized = glm::clamp(packet.depth / camera->getFarPlane(), 0.0f, 1.0f);
+	uint64_t depth = (uint64_t)(normalized * kDepthMask);
+
+	uint64_t key = (uint64_t)packet.pass << 62;
+
+	switch (packet.pass)
+	{
+	case kPassOpaque:
+		key |= program << 50 | texture << 38 | vao << 26 | depth << 2;
+		break;
+	case kPassTransparent:
+		key |= (kDepthMask - depth) << 38 | program << 26 | texture << 14 | vao << 2;
+		break;
+	default:
+		key |= (uint64_t)order;
+		break;
+	}
+
+	return key;
+}
+
+bool RenderQueue::canMerge(const DrawPacket& first, const DrawPacket& packet)
+{
+	// Uniforms would have to change between the draws, and blended passes
+	// are few enough that their order matters more
+	return packet.pass == kPassOpaque && packet.type == kDrawElements &&
+		!packet.hasModel && !packet.hasMaterial && !packet.hasColor &&
+		packet.program == first.program && packet.texture == first.texture &&
+		packet.vao == first.vao && packet.indexType == first.indexType;
+}
+
+void RenderQueue::buildRuns()
+{
+	size_t i = 0;
+
+	while (i < entries.size())
+	{
+		const DrawPacket& first = packets[entries[i].index];
+
+		size_t end = i + 1;
+
+		if (multiDraw && canMerge(first, first))
+		{
+			while (end < entries.size() &&
+				canMerge(first, packets[entries[end].index]))
+			{
+				end++;
+			}
+		}
+
+		uint32_t runLength = (uint32_t)(end - i);
+
+		DrawElementsIndirectCommand* commands = NULL;
+		GLintptr offset = 0;
+
+		if (runLength > 1)
+		{
+			commands = (DrawElementsIndirectCommand*)stream->allocate(
+				sizeof(DrawElementsIndirectCommand) * runLength,
+				sizeof(GLuint), &offset);
+		}
+
+		// Out of stream space, draw the run one packet at a time
+		if (commands == NULL)
+		{
+			for (; i < end; i++)
+			{
+				entries[i].runLength	= 1;
+				entries[i].commands		= 0;
+			}
+
+			continue;
+		}
+
+		entries[i].runLength	= runLength;
+		entries[i].commands		= offset;
+
+		for (uint32_t j = 0; j < runLength; j++)
+		{
+			const DrawPacket& packet = packets[entries[i + j].index];
+
+			commands[j].count			= (GLuint)packet.count;
+			commands[j].instanceCount	= (GLuint)packet.instanceCount;
+			commands[j].firstIndex		= packet.first;
+			commands[j].baseVertex		= packet.baseVertex;
+			commands[j].baseInstance	= packet.baseInstance;
+		}
+
+		i = end;
+	}
+}
+
+void RenderQueue::draw(const DrawPacket& packet)
+{
+	// Uniforms that aren't in the program have location -1 and are ignored
+	if (packet.hasModel)
+	{
+		glUniformMatrix4fv(packet.program->getUniformLocation(kUniformModel), 1,
+			GL_FALSE, glm::value_ptr(packet.model));
+	}
+
+	if (packet.hasMaterial)
+	{
+		glUniform1f(packet.program->getUniformLocation(kUniformSpecularStrength),
+			packet.material.x);
+		glUniform1f(packet.program->getUniformLocation(kUniformAmbientStrength),
+			packet.material.y);
+	}
+
+	if (packet.hasColor)
+	{
+		glUniform3f(packet.program->getUniformLocation(kUniformTextColor),
+			packet.color.x, packet.color.y, packet.color.z);
+	}
+
+	if (packet.type == kDrawElements)
+	{
+		size_t indexSize = packet.indexType == GL_UNSIGNED_SHORT ?
+			sizeof(uint16_t) : sizeof(uint32_t);
+		void* offset = (void*)(packet.first * indexSize);
+
+		if (packet.instanceCount == 1 && packet.baseInstance == 0)
+		{
+			glDrawElementsBaseVertex(GL_TRIANGLES, packet.count,
+				packet.indexType, offset, packet.baseVertex);
+		}
+		else
+		{
+			glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES,
+				packet.count, packet.indexType, offset, packet.instanceCount,
+				packet.baseVertex, packet.baseInstance);
+		}
+	}
+	else
+	{
+		if (packet.instanceCount == 1 && packet.baseInstance == 0)
+		{
+			glDrawArrays(GL_TRIANGLES, packet.first, packet.count);
+		}
+		else
+		{
+			glDrawArraysInstancedBaseInstance(GL_TRIANGLES, packet.first,
+				packet.count, packet.instanceCount, packet.baseInstance);
+		}
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "Camera.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Passes run in this order
+enum RenderPass {
+	kPassOpaque = 0,		// grouped by state, front to back within a group
+	kPassTransparent,		// blended, back to front
+	kPassOverlay,			// blended screen space, in submission order
+	kPassCount
+};
+
+enum DrawType {
+	kDrawElements = 0,		// indices from the VAO's element buffer
+	kDrawArrays
+};
+
+// One draw call and the state it needs. Per-object uniforms travel with the
+// packet, program, texture and VAO are only bound when they differ from the
+// previous packet.
+struct DrawPacket
+{
+	DrawPacket();
+
+	RenderPass		pass;
+	float			depth;			// distance from the camera
+	ShaderProgram*	program;
+	GLuint			texture;
+	GLuint			vao;
+
+	DrawType		type;
+	GLsizei			count;			// indices or vertices
+	GLuint			first;			// first index or vertex
+	GLint			baseVertex;		// added to each index
+	GLenum			indexType;		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+	GLsizei			instanceCount;
+	GLuint			baseInstance;
+
+	bool			hasModel;
+	glm::mat4		model;
+	bool			hasMaterial;
+	glm::vec2		material;		// x = specular strength, y = ambient strength
+	bool			hasColor;
+	glm::vec3		color;			// text colour, programs may be shared
+};
+
+// Layout glMultiDrawElementsIndirect reads
+struct DrawElementsIndirectCommand
+{
+	GLuint	count;
+	GLuint	instanceCount;
+	GLuint	firstIndex;
+	GLint	baseVertex;
+	GLuint	baseInstance;
+};
+
+// Collects the frame's draw packets, sorts them once by a 64-bit key and
+// submits them with as few program, texture and VAO binds as possible.
+// Consecutive opaque packets that share all three and carry no per-object
+// uniforms are merged into one glMultiDrawElementsIndirect, their commands
+// written to the stream buffer. Per-draw data has to come in through
+// baseInstance.
+//
+// Key layout, most significant first:
+//   opaque:				pass | program | texture | vao | depth
+//   transparent:			pass | inverted depth | program | texture | vao
+//   overlay:				pass | submission order
+class RenderQueue
+{
+public:
+	RenderQueue(Camera* inCamera, StreamBuffer* inStream);
+	~RenderQueue();
+
+	void submit(const DrawPacket& packet);
+
+	// Sorts, draws and clears the queue. Flushes the stream once the merged
+	// draws' commands are written, call before its endFrame().
+	void execute();
+
+	// Last execute()
+	int getPacketCount();
+	int getDrawCallCount();
+	int getBindCount();
+	int getSkippedBindCount();
+
+private:
+
+	struct SortEntry
+	{
+		uint64_t	key;
+		uint32_t	index;		// into packets
+		uint32_t	runLength;	// packets drawn from here, merged if > 1
+		GLintptr	commands;	// stream offset of the run's commands
+	};
+
+	uint64_t makeKey(const DrawPacket& packet, uint32_t order);
+	bool canMerge(const DrawPacket& first, const DrawPacket& packet);
+	void buildRuns();
+	void draw(const DrawPacket& packet);
+
+	Camera*					camera;
+	StreamBuffer*			stream;
+	bool					multiDraw;		// ARB_multi_draw_indirect
+	std::vector<DrawPacket>	packets;
+	std::vector<SortEntry>	entries;
+	int						packetCount;
+	int						drawCallCount;
+	int						bindCount;
+	int						skippedBindCount;
+};
@@ -1,37 +1,175 @@
 #include "ShaderLoader.h"
 
+// Declarations every stage gets, so blocks shared between stages can't
+// drift apart
+static const char* sharedShaderFilename = "Assets/Shaders/FrameData.glsl";
 
-GLuint ShaderLoader::createProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename)
+// Where linked program binaries are kept between runs
+static const char* programCacheDirectory = "ShaderCache";
+
+// Written at the start of every cache file
+struct ProgramBinaryHeader
 {
-	std::string vertexShaderCode	= readShader(vertexShaderFilename);
-	std::string fragmentShaderCoder = readShader(fragmentShaderFilename);
+	uint32_t magic;
+	uint32_t format;	// GLenum from glGetProgramBinary
+	uint32_t length;	// bytes of binary data following the header
+};
 
-	GLuint vertexShader		= createShader(GL_VERTEX_SHADER, vertexShaderCode, "vertex shader");
-	GLuint fragmentShader	= createShader(GL_FRAGMENT_SHADER, fragmentShaderCoder, "fragment shader");
+static const uint32_t programBinaryMagic = 0x42505347; // "GSPB"
 
-	int linkResult = 0;
+// 64-bit FNV-1a, folded over several strings
+static uint64_t hashString(const std::string& text, uint64_t hash)
+{
+	for (unsigned char c : text)
+	{
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
 
-	// Create the program handle, attach the shaders and link it
-	GLuint program = glCreateProgram();
-	glAttachShader(program, vertexShader);
-	glAttachShader(program, fragmentShader);
+	return hash;
+}
+
+ShaderLoader::ShaderLoader()
+{
+	// Let the driver compile and link on its own worker threads. Without the
+	// extension every queued program is completed on the next update().
+	parallelCompile = GLEW_KHR_parallel_shader_compile;
+
+	if (parallelCompile)
+	{
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	}
+
+	sharedCode = readShader(sharedShaderFilename);
+}
+
+ShaderLoader::~ShaderLoader()
+{
+	finish();
+}
+
+ShaderProgram* ShaderLoader::createProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename)
+{
+	ShaderProgram* program = queueProgram(vertexShaderFilename, fragmentShaderFilename);
+	finish();
+
+	return program;
+}
+
+ShaderProgram* ShaderLoader::queueProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename)
+{
+	std::string vertexShaderCode	= addSharedCode(readShader(vertexShaderFilename));
+	std::string fragmentShaderCoder = addSharedCode(readShader(fragmentShaderFilename));
+
+	// Skip compiling and linking when the driver accepts a cached binary.
+	// The shared code is hashed with the rest, editing it misses the cache.
+	std::string cachePath = getCachePath(vertexShaderCode, fragmentShaderCoder);
+	GLuint cachedProgram = loadProgramBinary(cachePath);
+
+	if (cachedProgram != 0)
+	{
+		return new ShaderProgram(cachedProgram);
+	}
+
+	PendingProgram pendingProgram;
+	pendingProgram.program			= new ShaderProgram();
+	pendingProgram.vertexShader		= createShader(GL_VERTEX_SHADER, vertexShaderCode);
+	pendingProgram.fragmentShader	= createShader(GL_FRAGMENT_SHADER, fragmentShaderCoder);
+	pendingProgram.cachePath		= cachePath;
+
+	// Create the program handle, attach the shaders and link it. Nothing is
+	// queried here, so the link is queued behind the compiles.
+	pendingProgram.id = glCreateProgram();
+	glAttachShader(pendingProgram.id, pendingProgram.vertexShader);
+	glAttachShader(pendingProgram.id, pendingProgram.fragmentShader);
+
+	glProgramParameteri(pendingProgram.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(pendingProgram.id);
+
+	pending.push_back(pendingProgram);
 
-	glLinkProgram(program);
+	return pendingProgram.program;
+}
+
+bool ShaderLoader::update()
+{
+	for (size_t i = 0; i < pending.size();)
+	{
+		GLint completed = GL_TRUE;
+
+		if (parallelCompile)
+		{
+			glGetProgramiv(pending[i].id, GL_COMPLETION_STATUS_KHR, &completed);
+		}
+
+		if (completed == GL_TRUE)
+		{
+			completeProgram(pending[i]);
+			pending.erase(pending.begin() + i);
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	return pending.empty();
+}
+
+void ShaderLoader::finish()
+{
+	// Querying the link status waits for the driver, so no polling needed
+	for (PendingProgram& pendingProgram : pending)
+	{
+		completeProgram(pendingProgram);
+	}
+
+	pending.clear();
+}
+
+int ShaderLoader::getPendingCount()
+{
+	return (int)pending.size();
+}
+
+void ShaderLoader::completeProgram(PendingProgram& pendingProgram)
+{
+	GLuint program = pendingProgram.id;
+
+	bool compiled = checkShader(pendingProgram.vertexShader, "vertex shader");
+	compiled = checkShader(pendingProgram.fragmentShader, "fragment shader") && compiled;
+
+	int linkResult = 0;
 	glGetProgramiv(program, GL_LINK_STATUS, &linkResult);
 
 	// Check for errors
-	if (linkResult == GL_FALSE)
+	if (compiled && linkResult == GL_FALSE)
 	{
 		int infoLogLength = 0;
 		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLogLength);
-		std::vector<char> programLog(infoLogLength);
+		std::vector<char> programLog(infoLogLength + 1);
 
-		glGetShaderInfoLog(program, infoLogLength, NULL, &programLog[0]);
+		glGetProgramInfoLog(program, infoLogLength, NULL, &programLog[0]);
 		std::cout << "Shader Loader : LINK ERROR" << '\n' << &programLog[0] << '\n';
-		return 0;
 	}
 
-	return program;
+	// The shaders are no longer needed once the program is linked
+	glDetachShader(program, pendingProgram.vertexShader);
+	glDetachShader(program, pendingProgram.fragmentShader);
+	glDeleteShader(pendingProgram.vertexShader);
+	glDeleteShader(pendingProgram.fragmentShader);
+
+	if (!compiled || linkResult == GL_FALSE)
+	{
+		glDeleteProgram(program);
+		pendingProgram.program->resolve(0);
+		return;
+	}
+
+	saveProgramBinary(program, pendingProgram.cachePath);
+
+	// Uniform locations and blocks are reflected once here
+	pendingProgram.program->resolve(program);
 }
 
 std::string ShaderLoader::readShader(const char* filename)
@@ -54,15 +192,34 @@ std::string ShaderLoader::readShader(const char* filename)
 	return shaderCode;
 }
 
-GLuint ShaderLoader::createShader(GLenum shaderType, std::string source, const char* shaderName)
+std::string ShaderLoader::addSharedCode(const std::string& source)
+{
+	size_t lineEnd = source.find('\n');
+
+	if (lineEnd == std::string::npos)
+	{
+		return source;
+	}
+
+	return source.substr(0, lineEnd + 1) + sharedCode + "\n#line 2\n" +
+		source.substr(lineEnd + 1);
+}
+
+GLuint ShaderLoader::createShader(GLenum shaderType, std::string source)
 {
-	int compileResult = 0;
 	GLuint shader = glCreateShader(shaderType);
 	const char* shaderCodePtr = source.c_str();
 	const int shaderCodeSize = source.size();
 
 	glShaderSource(shader, 1, &shaderCodePtr, &shaderCodeSize);
 	glCompileShader(shader);
+
+	return shader;
+}
+
+bool ShaderLoader::checkShader(GLuint shader, const char* shaderName)
+{
+	int compileResult = 0;
 	glGetShaderiv(shader, GL_COMPILE_STATUS, &compileResult);
 
 	// Check for errors
@@ -70,11 +227,128 @@ GLuint ShaderLoader::createShader(GLenum shaderType, std::string source, const c
 	{
 		int infoLogLength = 0;
 		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-		std::vector<char> shaderLog(infoLogLength);
+		std::vector<char> shaderLog(infoLogLength + 1);
 		glGetShaderInfoLog(shader, infoLogLength, NULL, &shaderLog[0]);
 		std::cout << "Error compiling shader: " << shaderName << '\n' << &shaderLog[0] << '\n';
+		return false;
+	}
+
+	return true;
+}
+
+std::string ShaderLoader::getCachePath(const std::string& vertexShaderCode, const std::string& fragmentShaderCode)
+{
+	// A driver update or a different GPU invalidates every binary
+	const char* vendor		= (const char*)glGetString(GL_VENDOR);
+	const char* renderer	= (const char*)glGetString(GL_RENDERER);
+	const char* version		= (const char*)glGetString(GL_VERSION);
+
+	uint64_t hash = 14695981039346656037ull;
+	hash = hashString(vendor ? vendor : "", hash);
+	hash = hashString(renderer ? renderer : "", hash);
+	hash = hashString(version ? version : "", hash);
+	hash = hashString(vertexShaderCode, hash);
+	hash = hashString(std::string(1, '\0'), hash);
+	hash = hashString(fragmentShaderCode, hash);
+
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)hash);
+
+	return std::string(programCacheDirectory) + "/" + name;
+}
+
+GLuint ShaderLoader::loadProgramBinary(const std::string& cachePath)
+{
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+	if (formatCount == 0)
+	{
 		return 0;
 	}
 
-	return shader;
+	std::ifstream file(cachePath, std::ios::in | std::ios::binary);
+
+	if (!file.good())
+	{
+		return 0;
+	}
+
+	file.seekg(0, std::ios::end);
+	std::streamoff fileLength = file.tellg();
+	file.seekg(0, std::ios::beg);
+
+	ProgramBinaryHeader header;
+	file.read((char*)&header, sizeof(header));
+
+	if (!file.good() || header.magic != programBinaryMagic || header.length == 0)
+	{
+		return 0;
+	}
+
+	// A truncated or corrupt file is a miss, the binary must fill the rest
+	// of it exactly
+	if ((std::streamoff)header.length != fileLength - (std::streamoff)sizeof(header))
+	{
+		return 0;
+	}
+
+	std::vector<char> binary(header.length);
+	file.read(&binary[0], header.length);
+
+	if (!file.good())
+	{
+		return 0;
+	}
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, header.format, &binary[0], header.length);
+
+	// The driver may reject binaries from another version, fall back to a
+	// full compile in that case
+	int linkResult = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &linkResult);
+
+	if (linkResult == GL_FALSE)
+	{
+		std::cout << "Shader Loader : cached binary rejected " << cachePath << '\n';
+		glDeleteProgram(program);
+		return 0;
+	}
+
+	return program;
+}
+
+void ShaderLoader::saveProgramBinary(GLuint program, const std::string& cachePath)
+{
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+	if (length <= 0)
+	{
+		return;
+	}
+
+	ProgramBinaryHeader header;
+	header.magic	= programBinaryMagic;
+	header.length	= (uint32_t)length;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(program, length, NULL, &format, &binary[0]);
+	header.format = format;
+
+	std::error_code error;
+	std::filesystem::create_directories(programCacheDirectory, error);
+
+	std::ofstream file(cachePath, std::ios::out | std::ios::binary);
+
+	if (!file.good())
+	{
+		std::cout << "Shader Loader : can't write " << cachePath << '\n';
+		return;
+	}
+
+	file.write((const char*)&header, sizeof(header));
+	file.write(&binary[0], length);
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
-#include <gl/glew.h>
+#include <GL/glew.h>
+
+#include "ShaderProgram.h"
 
 // std
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -11,11 +16,54 @@
 class ShaderLoader
 {
 public:
+	ShaderLoader();
+	~ShaderLoader();
+
+	// Compiles and links straight away, the program is ready on return
+	ShaderProgram* createProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename);
+
+	// Submits the compile and link without waiting for them. The returned
+	// program reports isReady() once update() sees the driver has finished.
+	// Queue every program before the first update() so the driver can work
+	// on all of them at once.
+	ShaderProgram* queueProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename);
+
+	// Completes any queued programs the driver has finished with, returns
+	// true when nothing is left pending
+	bool update();
+
+	// Blocks until every queued program is complete
+	void finish();
 
-	GLuint createProgram(const char* vertexShaderFilename, const char* fragmentShaderFilename);
+	int getPendingCount();
 
 private:
 
+	struct PendingProgram
+	{
+		ShaderProgram*	program;
+		GLuint			id;
+		GLuint			vertexShader;
+		GLuint			fragmentShader;
+		std::string		cachePath;
+	};
+
 	std::string readShader(const char* filename);
-	GLuint createShader(GLenum shaderType, std::string source, const char* shaderName);
+
+	// Inserts sharedCode after the #version line, a #line directive keeps
+	// compile errors pointing at the file's own lines
+	std::string addSharedCode(const std::string& source);
+	GLuint createShader(GLenum shaderType, std::string source);
+	bool checkShader(GLuint shader, const char* shaderName);
+	void completeProgram(PendingProgram& pendingProgram);
+
+	// Linked programs are cached on disk with glGetProgramBinary, keyed by a
+	// hash of both sources and the driver's vendor/renderer/version strings
+	std::string getCachePath(const std::string& vertexShaderCode, const std::string& fragmentShaderCode);
+	GLuint loadProgramBinary(const std::string& cachePath);
+	void saveProgramBinary(GLuint program, const std::string& cachePath);
+
+	bool						parallelCompile;	// GL_KHR_parallel_shader_compile
+	std::string					sharedCode;			// declarations every stage needs
+	std::vector<PendingProgram>	pending;
 };
\ No newline at end of file
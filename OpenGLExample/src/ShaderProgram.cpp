@@ -0,0 +1,198 @@
+#include "ShaderProgram.h"
+
+// Names of the uniforms behind each UniformSlot, in enum order
+static const char* slotNames[kUniformSlotCount] = {
+	"model",
+	"specularStrength",
+	"ambientStrength",
+	"projection",
+	"textColor"
+};
+
+// Names of the shared uniform blocks and the binding point each one uses
+static const std::pair<const char*, GLuint> blockBindings[] = {
+	{ "FrameData", kFrameDataBinding }
+};
+
+// Same for shader storage blocks
+static const std::pair<const char*, GLuint> storageBindings[] = {
+	{ "LightData", kLightDataBinding },
+	{ "ClusterData", kClusterDataBinding },
+	{ "LightIndexData", kLightIndexBinding },
+	{ "ModelData", kModelDataBinding },
+	{ "NormalData", kNormalDataBinding }
+};
+
+ShaderProgram::ShaderProgram()
+{
+	id		= 0;
+	ready	= false;
+
+	for (int i = 0; i < kUniformSlotCount; i++)
+	{
+		slotLocations[i] = -1;
+	}
+}
+
+ShaderProgram::ShaderProgram(GLuint inID) : ShaderProgram()
+{
+	resolve(inID);
+}
+
+ShaderProgram::~ShaderProgram()
+{
+	glDeleteProgram(id);
+}
+
+void ShaderProgram::resolve(GLuint inID)
+{
+	id		= inID;
+	ready	= true;
+
+	if (id != 0)
+	{
+		reflect();
+	}
+}
+
+void ShaderProgram::use()
+{
+	glUseProgram(id);
+}
+
+bool ShaderProgram::isReady()
+{
+	return ready;
+}
+
+GLuint ShaderProgram::getID()
+{
+	return id;
+}
+
+GLint ShaderProgram::getUniformLocation(UniformSlot slot)
+{
+	return slotLocations[slot];
+}
+
+GLint ShaderProgram::getUniformLocation(const std::string& name)
+{
+	auto it = uniforms.find(name);
+
+	if (it == uniforms.end())
+	{
+		return -1;
+	}
+
+	return it->second.location;
+}
+
+bool ShaderProgram::hasUniformBlock(const std::string& name)
+{
+	return uniformBlocks.find(name) != uniformBlocks.end();
+}
+
+void ShaderProgram::reflect()
+{
+	GLint maxNameLength = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+	GLint maxBlockNameLength = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH,
+		&maxBlockNameLength);
+	GLint maxStorageNameLength = 0;
+	glGetProgramInterfaceiv(id, GL_SHADER_STORAGE_BLOCK, GL_MAX_NAME_LENGTH,
+		&maxStorageNameLength);
+
+	std::vector<char> name(std::max(std::max(maxNameLength, maxBlockNameLength),
+		maxStorageNameLength) + 1);
+
+	// Active uniforms, including members of uniform blocks
+	GLint uniformCount = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+	for (GLint i = 0; i < uniformCount; i++)
+	{
+		GLsizei nameLength = 0;
+		UniformInfo info;
+
+		glGetActiveUniform(id, i, (GLsizei)name.size(), &nameLength,
+			&info.size, &info.type, &name[0]);
+
+		std::string uniformName(&name[0], nameLength);
+
+		// Arrays are reported as "name[0]", store them under "name"
+		size_t bracket = uniformName.find('[');
+		if (bracket != std::string::npos)
+		{
+			uniformName.resize(bracket);
+		}
+
+		info.location = glGetUniformLocation(id, uniformName.c_str());
+		uniforms[uniformName] = info;
+	}
+
+	for (int i = 0; i < kUniformSlotCount; i++)
+	{
+		slotLocations[i] = getUniformLocation(slotNames[i]);
+	}
+
+	// Active uniform blocks, wired to their shared binding points
+	GLint blockCount = 0;
+	glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+
+	for (GLint i = 0; i < blockCount; i++)
+	{
+		GLsizei nameLength = 0;
+		glGetActiveUniformBlockName(id, i, (GLsizei)name.size(), &nameLength,
+			&name[0]);
+
+		std::string blockName(&name[0], nameLength);
+		uniformBlocks[blockName] = i;
+
+		bool bound = false;
+		for (const auto& binding : blockBindings)
+		{
+			if (blockName == binding.first)
+			{
+				glUniformBlockBinding(id, i, binding.second);
+				bound = true;
+			}
+		}
+
+		if (!bound)
+		{
+			std::cout << "Shader Program : no binding point for uniform block "
+				<< blockName << '\n';
+		}
+	}
+
+	// Active shader storage blocks, likewise
+	GLint storageCount = 0;
+	glGetProgramInterfaceiv(id, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES,
+		&storageCount);
+
+	for (GLint i = 0; i < storageCount; i++)
+	{
+		GLsizei nameLength = 0;
+		glGetProgramResourceName(id, GL_SHADER_STORAGE_BLOCK, i,
+			(GLsizei)name.size(), &nameLength, &name[0]);
+
+		std::string blockName(&name[0], nameLength);
+
+		bool bound = false;
+		for (const auto& binding : storageBindings)
+		{
+			if (blockName == binding.first)
+			{
+				glShaderStorageBlockBinding(id, i, binding.second);
+				bound = true;
+			}
+		}
+
+		if (!bound)
+		{
+			std::cout << "Shader Program : no binding point for storage block "
+				<< blockName << '\n';
+		}
+	}
+}
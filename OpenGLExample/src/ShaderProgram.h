@@ -0,0 +1,73 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// std
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per-draw uniforms the renderers set. Their locations are looked up once when
+// the program is linked so draw() never has to search by name.
+enum UniformSlot {
+	kUniformModel = 0,
+	kUniformSpecularStrength,
+	kUniformAmbientStrength,
+	kUniformProjection,
+	kUniformTextColor,
+	kUniformSlotCount
+};
+
+// Binding points for uniform blocks shared by every program
+enum UniformBlockBinding {
+	kFrameDataBinding = 0
+};
+
+// Binding points for shader storage blocks, see ClusteredLighting and
+// TransformBuffer
+enum StorageBlockBinding {
+	kLightDataBinding = 0,
+	kClusterDataBinding,
+	kLightIndexBinding,
+	kModelDataBinding,
+	kNormalDataBinding
+};
+
+struct UniformInfo
+{
+	GLint	location;	// -1 for members of a uniform block
+	GLenum	type;		// GL_FLOAT_MAT4, GL_FLOAT_VEC3, ...
+	GLint	size;		// array length, 1 for non-arrays
+};
+
+class ShaderProgram
+{
+public:
+	ShaderProgram();	// still compiling, see ShaderLoader::queueProgram
+	ShaderProgram(GLuint inID);
+	~ShaderProgram();
+
+	// Called once the program has linked, id 0 marks a failed link
+	void resolve(GLuint inID);
+
+	void use();
+
+	bool isReady();
+	GLuint getID();
+	GLint getUniformLocation(UniformSlot slot);
+	GLint getUniformLocation(const std::string& name);
+	bool hasUniformBlock(const std::string& name);
+
+private:
+
+	void reflect();
+
+	GLuint id;
+	bool ready;
+	GLint slotLocations[kUniformSlotCount];
+
+	std::unordered_map<std::string, UniformInfo>	uniforms;
+	std::unordered_map<std::string, GLuint>			uniformBlocks;
+};
@@ -1,65 +1,342 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "bullet/btBulletDynamicsCommon.h"
+#include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <thread>
 
 #include "ShaderLoader.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+#include "FrameUniformBuffer.h"
+#include "GeometryRegistry.h"
+#include "HeadlessContext.h"
+#include "InputRecording.h"
 #include "Camera.h"
+#include "Benchmark.h"
+#include "ClusteredLighting.h"
+#include "CollisionEvents.h"
+#include "EntityStore.h"
 #include "LightRenderer.h"
-#include "MeshRenderer.h"
+#include "InstancedRenderer.h"
+#include "PhysicsTaskScheduler.h"
+#include "Profiler.h"
+#include "RenderQueue.h"
 #include "TextureLoader.h"
 #include "TextRenderer.h"
+#include "TransformBuffer.h"
 
 Camera*			camera;
 LightRenderer*	light;
-MeshRenderer*	sphere;
-MeshRenderer*	ground;
-MeshRenderer*	enemy;
 TextRenderer*	label;
+TextRenderer*	profilerLabel;
 
-GLuint flatShaderProgram;
-GLuint texturedShaderProgram;
-GLuint litTexturedShaderProgram;
-GLuint textProgram;
-GLuint sphereTexture;
-GLuint groundTexture;
+// Game objects live in the entity store, drawn by instancedRenderer
+EntityStore*	entities;
+Entity			hero;
+Entity			ground;
+Entity			enemy;
 
-btDiscreteDynamicsWorld* dynamicsWorld;
+InstancedRenderer* instancedRenderer;
+RenderQueue*		renderQueue;
+
+StreamBuffer*		frameStream;	// everything rewritten each frame
+FrameUniformBuffer* frameUniforms;
+TransformBuffer*	transformBuffer;
+ClusteredLighting*	lighting;
+ShaderLoader*		shaderLoader;
+TextureLoader*		textureLoader;
+
+ShaderProgram* flatShaderProgram;
+ShaderProgram* instancedShaderProgram;
+ShaderProgram* textProgram;
+
+btDiscreteDynamicsWorld* dynamicsWorld		= NULL;
+PhysicsTaskScheduler*	 physicsScheduler	= NULL;
+CollisionEvents*		 collisionEvents	= NULL;
 
 bool grounded	= false;
+int groundContacts = 0;	// ground pieces the hero touches
 bool gameOver	= true;
 int score		= 0;
 
+// Number of physics driven bodies in the stress scene, set with --cubes N or
+// --spheres N
+int			stressBodyCount = 0;
+MeshType	stressMeshType	= kCube;
+
+// Coloured point lights circling over the scene, set with --lights N
+int		pointLightCount	= 0;
+float	pointLightTime	= 0.0f;
+
+// Physics runs at a fixed rate, set with --physics-hz N. A slow frame
+// catches up with at most maxPhysicsSteps steps, set with --max-steps N,
+// any time beyond that is dropped instead of stalling further frames.
+float	physicsRate		= 120.0f;
+int		maxPhysicsSteps	= 6;
+
+// With --physics-threads N, N > 1, collision detection and the solver run
+// on N threads in a btDiscreteDynamicsWorldMt. --physics-stats prints the
+// average stepSimulation time once a second.
+int		physicsThreadCount	= 1;
+bool	reportPhysics		= false;
+
+// Objects drawn and frustum culled last frame, printed once a second with
+// --cull-stats together with the render queue's bind counts
+int		visibleCount	= 0;
+int		culledCount		= 0;
+bool	reportCulling	= false;
+
+// Frame timings, F3 toggles the overlay (or --profile shows it from the
+// start) and F4 writes them to profileDumpFile, set with --profile-dump FILE.
+// Given that flag they are also written on exit.
+Profiler*	profiler;
+bool		showProfiler	= false;
+std::string	profileDumpFile	= "profile.csv";
+bool		dumpOnExit		= false;
+
+// --benchmark N renders N frames offscreen with scripted input and fixed
+// time steps, then writes timings and draw counts to benchmarkFile, set with
+// --benchmark-out FILE
+int			benchmarkFrames	= 0;
+std::string	benchmarkFile	= "benchmark.json";
+
+// --record FILE logs key presses and physics steps of a windowed session.
+// --replay FILE benchmarks that session instead of the scripted input, in
+// the scene it was recorded in, and checks the final rigid body states
+// match. Multi-threaded physics may not reproduce bit for bit.
+InputRecorder*	recorder		= NULL;
+InputPlayer*	player			= NULL;
+std::string		recordFile;
+
+void runWindowed(GLFWwindow* window);
+int updateFrame(float deltaTime, int physicsSteps);
+int runBenchmark();
 void renderScene();
 void initGame();
 void addRigidBodies();
+void addStressBodies(int count, MeshType meshType);
+void addPointLights(int count);
+void updatePointLights(float deltaTime);
 void 
 tickCallback(btDynamicsWorld* dynamicsWorld, btScalar timeStep);
+void heroEnemyContact(const CollisionEvent& event);
+void heroGroundContact(const CollisionEvent& event);
 void updateKeyboard(GLFWwindow* window, int key, int scancode, int action,
 	int mods);
+void handleGameKey(int key, int action);
+void jump();
 
 static void glfwError(int id, const char* description)
 {
 	std::cout << description << '\n';
 }
 
-int main()
+int main(int argc, char** argv)
 {
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--cubes") == 0 && i + 1 < argc)
+		{
+			stressBodyCount	= std::stoi(argv[++i]);
+			stressMeshType	= kCube;
+		}
+		else if (strcmp(argv[i], "--spheres") == 0 && i + 1 < argc)
+		{
+			stressBodyCount	= std::stoi(argv[++i]);
+			stressMeshType	= kIcosphere;
+		}
+		else if (strcmp(argv[i], "--lights") == 0 && i + 1 < argc)
+		{
+			pointLightCount = std::stoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--physics-hz") == 0 && i + 1 < argc)
+		{
+			physicsRate = std::stof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc)
+		{
+			maxPhysicsSteps = std::stoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--physics-threads") == 0 && i + 1 < argc)
+		{
+			physicsThreadCount = std::stoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--physics-stats") == 0)
+		{
+			reportPhysics = true;
+		}
+		else if (strcmp(argv[i], "--cull-stats") == 0)
+		{
+			reportCulling = true;
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			showProfiler = true;
+		}
+		else if (strcmp(argv[i], "--profile-dump") == 0 && i + 1 < argc)
+		{
+			profileDumpFile	= argv[++i];
+			dumpOnExit		= true;
+		}
+		else if (strcmp(argv[i], "--benchmark") == 0 && i + 1 < argc)
+		{
+			benchmarkFrames = std::stoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--benchmark-out") == 0 && i + 1 < argc)
+		{
+			benchmarkFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			recordFile = argv[++i];
+		}
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			player = new InputPlayer();
+
+			if (!player->open(argv[++i]))
+			{
+				std::cout << "Can't read recording " << argv[i] << '\n';
+				delete player;
+				return 1;
+			}
+		}
+	}
+
+	// A replay rebuilds the recorded scene and runs as a benchmark over at
+	// most the recorded frames
+	if (player != NULL)
+	{
+		const RecordingScene& scene = player->getScene();
+
+		physicsRate		= scene.physicsRate;
+		stressBodyCount	= scene.bodyCount;
+		stressMeshType	= (MeshType)scene.meshType;
+		pointLightCount	= scene.lightCount;
+
+		if (benchmarkFrames <= 0 || benchmarkFrames > player->getFrameCount())
+		{
+			benchmarkFrames = player->getFrameCount();
+		}
+
+		if (benchmarkFrames <= 0)
+		{
+			std::cout << "Recording has no frames" << '\n';
+			delete player;
+			return 1;
+		}
+	}
+
 	glfwSetErrorCallback(&glfwError);
 
-	glfwInit();
-	GLFWwindow* window = glfwCreateWindow(800, 600, " Hello OpenGL ", NULL, NULL);
+	// Benchmarks render offscreen, everything else gets a window
+	HeadlessContext*	headless	= NULL;
+	GLFWwindow*			window		= NULL;
 
-	glfwMakeContextCurrent(window);
+	if (benchmarkFrames > 0)
+	{
+		headless = new HeadlessContext();
 
-	glfwSetKeyCallback(window, updateKeyboard);
+		if (!headless->create(800, 600))
+		{
+			delete headless;
+			glfwTerminate();
+			return 1;
+		}
+	}
+	else
+	{
+		glfwInit();
+		window = glfwCreateWindow(800, 600, " Hello OpenGL ", NULL, NULL);
+
+		glfwMakeContextCurrent(window);
 
-	glewInit();
+		glfwSetKeyCallback(window, updateKeyboard);
+
+		glewInit();
+	}
 
 	initGame();
 
+	if (!recordFile.empty() && benchmarkFrames <= 0)
+	{
+		RecordingScene scene;
+		scene.physicsRate	= physicsRate;
+		scene.bodyCount		= stressBodyCount;
+		scene.meshType		= stressMeshType;
+		scene.lightCount	= pointLightCount;
+
+		recorder = new InputRecorder();
+
+		if (!recorder->open(recordFile, scene))
+		{
+			std::cout << "Can't write recording " << recordFile << '\n';
+			delete recorder;
+			recorder = NULL;
+		}
+	}
+
+	int result = 0;
+
+	if (benchmarkFrames > 0)
+	{
+		result = runBenchmark();
+	}
+	else
+	{
+		runWindowed(window);
+	}
+
+	// GL objects go before the context that owns them
+	delete camera;
+	delete light;
+	delete frameUniforms;
+	delete transformBuffer;
+	delete lighting;
+	delete instancedRenderer;
+	delete frameStream;
+	delete entities;
+	delete renderQueue;
+
+	// The Mt world calls into the scheduler, and Bullet keeps a global
+	// pointer to it, so both are let go before it is freed
+	delete dynamicsWorld;
+	btSetTaskScheduler(btGetSequentialTaskScheduler());
+	delete physicsScheduler;
+
+	delete collisionEvents;
+	delete shaderLoader;	// finishes pending programs, so before them
+	delete flatShaderProgram;
+	delete instancedShaderProgram;
+	delete textProgram;
+	delete textureLoader;
+	delete profiler;
+	delete profilerLabel;
+	delete label;
+	delete recorder;
+	delete player;
+
+	GeometryRegistry::shutdown();
+
+	delete headless;
+	glfwTerminate();
+
+	return result;
+}
+
+void runWindowed(GLFWwindow* window)
+{
 	auto previousTime = std::chrono::high_resolution_clock::now();
+	auto reportTime	  = previousTime;
+	auto overlayTime  = previousTime;
 
 	while (!glfwWindowShouldClose(window))
 	{
@@ -67,20 +344,228 @@ int main()
 		float deltaTime	 = std::chrono::duration<float,
 			std::chrono::seconds::period>(currentTime - previousTime).count();
 
-		dynamicsWorld->stepSimulation(deltaTime);
+		profiler->beginFrame();
 
-		renderScene();
+		// Refreshing a few times a second keeps the text readable
+		if (showProfiler &&
+			currentTime - overlayTime >= std::chrono::milliseconds(250))
+		{
+			profilerLabel->setText(profiler->getReport());
+			overlayTime = currentTime;
+		}
+
+		int physicsSteps = updateFrame(deltaTime, -1);
+
+		if (recorder != NULL)
+		{
+			recorder->addFrame(deltaTime, physicsSteps);
+		}
+
+		if (currentTime - reportTime >= std::chrono::seconds(1))
+		{
+			if (reportCulling)
+			{
+				std::cout << "Visible: " << visibleCount << ", culled: " <<
+					culledCount << ", packets: " <<
+					renderQueue->getPacketCount() << ", draws: " <<
+					renderQueue->getDrawCallCount() << ", binds: " <<
+					renderQueue->getBindCount() << ", skipped: " <<
+					renderQueue->getSkippedBindCount() << ", light refs: " <<
+					lighting->getAssignedCount() << '\n';
+			}
+
+			if (reportPhysics)
+			{
+				ProfileStats stats = profiler->getStats(kProfilePhysics);
+
+				std::cout << "Physics: " << stats.average << " ms avg, " <<
+					stats.p99 << " ms p99 per frame on " << physicsThreadCount <<
+					" thread(s), " << dynamicsWorld->getNumCollisionObjects() <<
+					" objects" << '\n';
+			}
+
+			reportTime = currentTime;
+		}
+
+		{
+			ProfileScope scope(profiler, kProfileSwap);
+
+			glfwSwapBuffers(window);
+			glfwPollEvents();
+		}
 
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+		profiler->endFrame();
 
 		previousTime = currentTime;
 	}
 
-	glfwTerminate();
+	if (dumpOnExit && !profiler->dump(profileDumpFile))
+	{
+		std::cout << "Can't write profile " << profileDumpFile << '\n';
+	}
 
-	delete camera;
-	delete light;
+	if (recorder != NULL)
+	{
+		recorder->close(InputRecorder::hashState(dynamicsWorld));
+		std::cout << "Recording written to " << recordFile << '\n';
+	}
+}
+
+// physicsSteps < 0 steps in real time, otherwise exactly that many fixed
+// steps are taken. Returns the fixed steps taken.
+int updateFrame(float deltaTime, int physicsSteps)
+{
+	{
+		ProfileScope scope(profiler, kProfileLoaders);
+
+		// Pick up programs the driver has finished compiling
+		shaderLoader->update();
+
+		// Upload textures the workers have finished decoding
+		textureLoader->update();
+	}
+
+	{
+		ProfileScope scope(profiler, kProfilePhysics);
+
+		const float fixedStep = 1.0f / physicsRate;
+
+		if (physicsSteps < 0)
+		{
+			// Whole fixed steps only, the remainder carries over to the next
+			// frame. Bullet then writes transforms interpolated by that
+			// remainder into the motion states, which is what the renderers
+			// read. It reports the steps before clamping.
+			physicsSteps = std::min(dynamicsWorld->stepSimulation(deltaTime,
+				maxPhysicsSteps, fixedStep), maxPhysicsSteps);
+		}
+		else
+		{
+			// One step per call leaves no remainder to round, so the world
+			// sees the same steps as the session that was recorded
+			for (int step = 0; step < physicsSteps; step++)
+			{
+				dynamicsWorld->stepSimulation(fixedStep, 1, fixedStep);
+			}
+		}
+	}
+
+	updatePointLights(deltaTime);
+
+	{
+		ProfileScope scope(profiler, kProfileRender);
+
+		profiler->beginGpu();
+		renderScene();
+		profiler->endGpu();
+	}
+
+	return physicsSteps;
+}
+
+int runBenchmark()
+{
+	// Start measuring with every program linked and every texture resident
+	shaderLoader->finish();
+
+	while (textureLoader->getPendingCount() > 0)
+	{
+		textureLoader->update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	Benchmark benchmark;
+	benchmark.setParameter("frames", benchmarkFrames);
+	benchmark.setParameter("bodies", stressBodyCount);
+	benchmark.setParameter("mesh", stressMeshType == kIcosphere ? "sphere" :
+		"cube");
+	benchmark.setParameter("lights", pointLightCount);
+	benchmark.setParameter("physics_hz", (int)physicsRate);
+	benchmark.setParameter("physics_threads", physicsThreadCount);
+	benchmark.setParameter("renderer",
+		std::string((const char*)glGetString(GL_RENDERER)));
+	benchmark.setParameter("input", player != NULL ? "replay" : "scripted");
+
+	// Same simulated time on every host however long a frame takes
+	const float deltaTime = 1.0f / 60.0f;
+
+	int gpuSamples = 0;
+
+	for (int frame = 0; frame < benchmarkFrames; frame++)
+	{
+		profiler->beginFrame();
+
+		if (player != NULL)
+		{
+			const RecordedFrame& recorded = player->getFrame(frame);
+
+			for (size_t i = 0; i < recorded.keyCount; i++)
+			{
+				const RecordedKey& key = player->getKey(recorded.firstKey + i);
+				handleGameKey(key.key, key.action);
+			}
+
+			updateFrame(recorded.deltaTime, recorded.physicsSteps);
+		}
+		else
+		{
+			// Scripted input: the first press starts the round, later ones
+			// jump
+			if (frame % 60 == 0)
+			{
+				jump();
+			}
+
+			updateFrame(deltaTime, -1);
+		}
+
+		// Nothing is presented, wait for the GPU instead so its work counts
+		{
+			ProfileScope scope(profiler, kProfileSwap);
+			glFinish();
+		}
+
+		profiler->endFrame();
+
+		benchmark.addSample(kSeriesFrame, profiler->getLast(kProfileFrame));
+		benchmark.addSample(kSeriesPhysics, profiler->getLast(kProfilePhysics));
+		benchmark.addSample(kSeriesRender, profiler->getLast(kProfileRender));
+
+		// Timer query results arrive a few frames late, if at all
+		if (profiler->getSampleTotal(kProfileGpu) != gpuSamples)
+		{
+			gpuSamples = profiler->getSampleTotal(kProfileGpu);
+			benchmark.addSample(kSeriesGpu, profiler->getLast(kProfileGpu));
+		}
+
+		benchmark.addSample(kSeriesDrawCalls,
+			(float)renderQueue->getDrawCallCount());
+		benchmark.addSample(kSeriesPackets,
+			(float)renderQueue->getPacketCount());
+		benchmark.addSample(kSeriesBinds, (float)renderQueue->getBindCount());
+		benchmark.addSample(kSeriesVisible, (float)visibleCount);
+	}
+
+	// Only a replay of the whole recording ends in the recorded state
+	if (player != NULL && player->hasStateHash() &&
+		benchmarkFrames == player->getFrameCount())
+	{
+		bool match = InputRecorder::hashState(dynamicsWorld) ==
+			player->getStateHash();
+
+		benchmark.setParameter("replay_match", match ? "true" : "false");
+		std::cout << (match ? "Replay matches the recording" :
+			"Replay diverged from the recording") << '\n';
+	}
+
+	if (!benchmark.write(benchmarkFile))
+	{
+		std::cout << "Can't write benchmark results to " << benchmarkFile <<
+			'\n';
+		return 1;
+	}
+
+	std::cout << "Benchmark results written to " << benchmarkFile << '\n';
 
 	return 0;
 }
@@ -90,12 +575,42 @@ void renderScene()
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glClearColor(0.0, 0.0, 0.0, 1.0);
 
-	// Draw 
-	light->draw();
-	sphere->draw();
-	ground->draw();
-	enemy->draw();
-	label->draw();	// Must draw last
+	// Waits only if the GPU is still reading this partition from three
+	// frames back
+	frameStream->beginFrame();
+
+	// Camera and light data shared by every program, written once per frame
+	frameUniforms->update(camera, light, lighting);
+
+	// Point lights binned into the clusters the lit shader reads
+	lighting->update();
+
+	visibleCount	= 0;
+	culledCount		= 0;
+
+	// Everything submits packets, the queue sorts them by pass and state
+	// before drawing
+	light->submit(renderQueue);
+
+	instancedRenderer->submit(renderQueue, entities);
+	visibleCount	+= instancedRenderer->getVisibleCount();
+	culledCount		+= instancedRenderer->getCulledCount();
+
+	// Model and normal matrices once per object, the instances above only
+	// carry the entity's index into them
+	transformBuffer->update(entities);
+
+	label->submit(renderQueue);
+
+	if (showProfiler)
+	{
+		profilerLabel->submit(renderQueue);
+	}
+
+	// Writes the multi-draw commands and flushes the stream before drawing
+	renderQueue->execute();
+
+	frameStream->endFrame();
 }
 
 void initGame()
@@ -103,24 +618,23 @@ void initGame()
 	glEnable(GL_DEPTH_TEST);
 
 	// shader
-	ShaderLoader shader;
-
-	flatShaderProgram = shader.createProgram("Assets/Shaders/FlatModel.vs",
-		"Assets/Shaders/FlatModel.fs");
+	// All programs are queued together so the driver can compile them in
+	// parallel, the frame loop starts while they are still being built
+	shaderLoader = new ShaderLoader();
 
-	texturedShaderProgram = shader.createProgram(
-		"Assets/Shaders/TexturedModel.vs", "Assets/Shaders/TexturedModel.fs");
+	flatShaderProgram = shaderLoader->queueProgram(
+		"Assets/Shaders/FlatModel.vs", "Assets/Shaders/FlatModel.fs");
 
-	litTexturedShaderProgram = shader.createProgram(
-		"Assets/Shaders/LitTexturedModel.vs",
+	instancedShaderProgram = shaderLoader->queueProgram(
+		"Assets/Shaders/InstancedLitTexturedModel.vs",
 		"Assets/Shaders/LitTexturedModel.fs");
 
-	textProgram = shader.createProgram("Assets/Shaders/text.vs",
+	textProgram = shaderLoader->queueProgram("Assets/Shaders/text.vs",
 		"Assets/Shaders/text.fs");
 
-	TextureLoader tLoader;
-	sphereTexture = tLoader.getTextureID("Assets/Textures/globe.jpg");
-	groundTexture = tLoader.getTextureID("Assets/Textures/ground.jpg");
+	// Textures are shared by filename and show a placeholder until they have
+	// streamed in
+	textureLoader = new TextureLoader();
 
 	camera = new Camera(45.0f, 800, 600, 0.1f, 100.0f,
 		glm::vec3(0.0f, 4.0f, 20.0f));
@@ -131,27 +645,92 @@ void initGame()
 	light->setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
 	light->setColor(glm::vec3(1.0f, 1.0f, 1.0f));
 
+	// Room for every entity's instance data and matrices plus the frame
+	// uniforms, the multi-draw commands, the light clusters and alignment
+	// padding
+	size_t entityCapacity = 64 + std::max(stressBodyCount, 0);
+
+	frameStream = new StreamBuffer(
+		(GLsizeiptr)(entityCapacity * sizeof(InstanceData) + 64 * 1024) +
+		TransformBuffer::getFrameSize(entityCapacity) +
+		ClusteredLighting::getFrameSize());
+	frameUniforms = new FrameUniformBuffer(frameStream);
+	transformBuffer = new TransformBuffer(frameStream);
+	lighting = new ClusteredLighting(camera, frameStream, 800, 600);
+	instancedRenderer = new InstancedRenderer(camera, frameStream);
+
+	// Room for the game objects plus the stress scene, nothing allocates
+	// when entities come and go below this
+	entities = new EntityStore(entityCapacity);
+
+	renderQueue = new RenderQueue(camera, frameStream);
+
 	// UI
 	label = new TextRenderer("Score: 0", "Assets/Fonts/gooddog.ttf", 64,
 		glm::vec3(1.0f, 0.0f, 0.0f), textProgram);
 	label->setPosition(glm::vec2(320.0f, 500.0f));
 
+	// Frame timings in the top left corner
+	profiler = new Profiler();
+	profilerLabel = new TextRenderer("", "Assets/Fonts/gooddog.ttf", 20,
+		glm::vec3(1.0f, 1.0f, 1.0f), textProgram);
+	profilerLabel->setPosition(glm::vec2(10.0f, 580.0f));
+
 	// Physics
 	btBroadphaseInterface* broadphase = new btDbvtBroadphase();
+
+	// Room for the stress scene's contacts without falling back to the heap
+	btDefaultCollisionConstructionInfo collisionInfo;
+	collisionInfo.m_defaultMaxPersistentManifoldPoolSize	= 80000;
+	collisionInfo.m_defaultMaxCollisionAlgorithmPoolSize	= 80000;
+
 	btDefaultCollisionConfiguration* collisionConfiguration = new
-		btDefaultCollisionConfiguration();
-	btCollisionDispatcher* dispatcher = new btCollisionDispatcher(
-		collisionConfiguration);
-	btSequentialImpulseConstraintSolver* solver = new
-		btSequentialImpulseConstraintSolver();
-
-	dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase, solver,
-		collisionConfiguration);
+		btDefaultCollisionConfiguration(collisionInfo);
+
+	if (physicsThreadCount > 1)
+	{
+		// Bullet reads the scheduler while the world is built, so it goes in
+		// first
+		physicsScheduler = new PhysicsTaskScheduler(physicsThreadCount);
+		btSetTaskScheduler(physicsScheduler);
+
+		physicsThreadCount = physicsScheduler->getNumThreads();
+
+		btCollisionDispatcherMt* dispatcher = new btCollisionDispatcherMt(
+			collisionConfiguration);
+
+		// One solver per thread for independent islands, plus one that
+		// splits a single large island across the threads
+		btConstraintSolverPoolMt* solverPool = new btConstraintSolverPoolMt(
+			physicsThreadCount);
+		btSequentialImpulseConstraintSolverMt* solver = new
+			btSequentialImpulseConstraintSolverMt();
+
+		dynamicsWorld = new btDiscreteDynamicsWorldMt(dispatcher, broadphase,
+			solverPool, solver, collisionConfiguration);
+	}
+	else
+	{
+		physicsScheduler = NULL;
+
+		btCollisionDispatcher* dispatcher = new btCollisionDispatcher(
+			collisionConfiguration);
+		btSequentialImpulseConstraintSolver* solver = new
+			btSequentialImpulseConstraintSolver();
+
+		dynamicsWorld = new btDiscreteDynamicsWorld(dispatcher, broadphase,
+			solver, collisionConfiguration);
+	}
 	dynamicsWorld->setGravity(btVector3(0, -9.8f, 0));
 	dynamicsWorld->setInternalTickCallback(tickCallback);
 
-	addRigidBodies();
+	collisionEvents = new CollisionEvents();
+	collisionEvents->subscribe(kTagHero, kTagEnemy, heroEnemyContact);
+	collisionEvents->subscribe(kTagHero, kTagGround, heroGroundContact);
 
+	addRigidBodies();
+	addStressBodies(stressBodyCount, stressMeshType);
+	addPointLights(pointLightCount);
 }
 
 void addRigidBodies()
@@ -176,14 +755,11 @@ void addRigidBodies()
 
 	dynamicsWorld->addRigidBody(sphereRigidBody);
 
-	// Player Mesh (Sphere)
-	sphere = new MeshRenderer(MeshType::kSphere, "hero", camera,
-		sphereRigidBody, light, 0.1f, 0.5f);
-	sphere->setProgram(litTexturedShaderProgram);
-	sphere->setTexture(sphereTexture);
-	sphere->setScale(glm::vec3(1.0f));
-
-	sphereRigidBody->setUserPointer(sphere);
+	// Player Entity (Sphere)
+	hero = entities->spawn(sphereRigidBody, glm::vec3(1.0f),
+		instancedRenderer->getBatch(MeshType::kSphere, instancedShaderProgram,
+			textureLoader->getTexture("Assets/Textures/globe.jpg")),
+		glm::vec2(0.1f, 0.5f), kTagHero);
 
 	// Ground Rigid Body
 	btCollisionShape* groundShape = new btBoxShape(btVector3(4.0f, 0.5f, 4.0f));
@@ -202,14 +778,14 @@ void addRigidBodies()
 
 	dynamicsWorld->addRigidBody(groundRigidBody);
 
-	// Ground Mesh
-	ground = new MeshRenderer(MeshType::kCube, "ground", camera,
-		groundRigidBody, light, 0.1f, 0.5f);
-	ground->setProgram(litTexturedShaderProgram);
-	ground->setTexture(groundTexture);
-	ground->setScale(glm::vec3(4.0f, 0.5f, 4.0f));
+	// Ground and enemy share a batch
+	int cubeBatch = instancedRenderer->getBatch(MeshType::kCube,
+		instancedShaderProgram,
+		textureLoader->getTexture("Assets/Textures/ground.jpg"));
 
-	groundRigidBody->setUserPointer(ground);
+	// Ground Entity
+	ground = entities->spawn(groundRigidBody, glm::vec3(4.0f, 0.5f, 4.0f),
+		cubeBatch, glm::vec2(0.1f, 0.5f), kTagGround);
 
 	// Enemy Rigid Body
 	btCollisionShape* enemyShape = new btBoxShape(btVector3(1.0f, 1.0f, 1.0f));
@@ -227,22 +803,93 @@ void addRigidBodies()
 
 	dynamicsWorld->addRigidBody(enemyRigidBody);
 
-	// Enemy Mesh
-	enemy = new MeshRenderer(MeshType::kCube, "enemy", camera, enemyRigidBody,
-		light, 0.1f, 0.5f);
-	enemy->setProgram(litTexturedShaderProgram);
-	enemy->setTexture(groundTexture);
-	enemy->setScale(glm::vec3(1.0f, 1.0f, 1.0f));
+	// Enemy Entity
+	enemy = entities->spawn(enemyRigidBody, glm::vec3(1.0f, 1.0f, 1.0f),
+		cubeBatch, glm::vec2(0.1f, 0.5f), kTagEnemy);
+}
+
+void addStressBodies(int count, MeshType meshType)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	// Floor behind the play area for the bodies to land on
+	btCollisionShape* floorShape = new btBoxShape(btVector3(40.0f, 0.5f, 40.0f));
+	btDefaultMotionState* floorMotionState = new btDefaultMotionState(
+		btTransform(btQuaternion(0, 0, 0, 1), btVector3(0, -2.0f, -48.0f)));
+
+	btRigidBody::btRigidBodyConstructionInfo floorRigidBodyCI(0.0f,
+		floorMotionState, floorShape, btVector3(0, 0, 0));
+	btRigidBody* floorRigidBody = new btRigidBody(floorRigidBodyCI);
+
+	floorRigidBody->setCollisionFlags(btCollisionObject::CF_STATIC_OBJECT);
+	CollisionEvents::setTag(floorRigidBody, kTagProp);
+	dynamicsWorld->addRigidBody(floorRigidBody);
+
+	// All bodies share one collision shape and are drawn instanced
+	const float halfExtent = 0.25f;
+	btCollisionShape* bodyShape;
 
-	enemyRigidBody->setUserPointer(enemy);
+	if (meshType == kIcosphere)
+	{
+		bodyShape = new btSphereShape(halfExtent);
+	}
+	else
+	{
+		bodyShape = new btBoxShape(btVector3(halfExtent, halfExtent, halfExtent));
+	}
+
+	int bodyBatch = instancedRenderer->getBatch(meshType,
+		instancedShaderProgram,
+		textureLoader->getTexture("Assets/Textures/ground.jpg"));
+
+	btScalar mass = 1.0f;
+	btVector3 bodyInertia(0, 0, 0);
+	bodyShape->calculateLocalInertia(mass, bodyInertia);
+
+	// Stack the bodies in columns over a 60 x 60 area
+	const int columns = 60;
+
+	for (int i = 0; i < count; i++)
+	{
+		int column	= i % (columns * columns);
+		int layer	= i / (columns * columns);
+
+		float x = -30.0f + (column % columns) * 1.0f;
+		float z = -78.0f + (column / columns) * 1.0f;
+		float y = 2.0f + layer * 0.75f;
+
+		btDefaultMotionState* bodyMotionState = new btDefaultMotionState(
+			btTransform(btQuaternion(0, 0, 0, 1), btVector3(x, y, z)));
+
+		btRigidBody::btRigidBodyConstructionInfo bodyRigidBodyCI(mass,
+			bodyMotionState, bodyShape, bodyInertia);
+		btRigidBody* bodyRigidBody = new btRigidBody(bodyRigidBodyCI);
+
+		bodyRigidBody->setFriction(1.0f);
+		bodyRigidBody->setRestitution(0.0f);
+
+		dynamicsWorld->addRigidBody(bodyRigidBody);
+
+		entities->spawn(bodyRigidBody, glm::vec3(halfExtent), bodyBatch,
+			glm::vec2(0.1f, 0.5f), kTagProp);
+	}
+
+	std::cout << "Stress scene: " << entities->getCount() <<
+		" entities in " << instancedRenderer->getBatchCount() <<
+		" batch(es)" << '\n';
 }
 
 void tickCallback(btDynamicsWorld* dynamicsWorld, btScalar timeStep)
 {
+	btRigidBody* enemyRigidBody = entities->getBody(enemy);
+
 	if (!gameOver)
 	{
 		// Get Enemy transform
-		btTransform t(enemy->rigidBody->getWorldTransform());
+		btTransform t(enemyRigidBody->getWorldTransform());
 
 		// Set enemy position
 		t.setOrigin(t.getOrigin() + btVector3(-15, 0, 0) * timeStep);
@@ -254,62 +901,39 @@ void tickCallback(btDynamicsWorld* dynamicsWorld, btScalar timeStep)
 			score++;
 			label->setText("Score: " + std::to_string(score));
 		}
-		enemy->rigidBody->setWorldTransform(t);
-		enemy->rigidBody->getMotionState()->setWorldTransform(t);
+		enemyRigidBody->setWorldTransform(t);
+		enemyRigidBody->getMotionState()->setWorldTransform(t);
 	}
 
-	grounded = false;
+	collisionEvents->update(dynamicsWorld);
 
-	int numManifolds = dynamicsWorld->getDispatcher()->getNumManifolds();
+	grounded = groundContacts > 0;
+}
 
-	for (int i = 0; i < numManifolds; i++)
+void heroEnemyContact(const CollisionEvent& event)
+{
+	if (event.type != kContactBegin)
 	{
-		btPersistentManifold* contactManifold = dynamicsWorld->getDispatcher()->
-			getManifoldByIndexInternal(i);
-
-		int numContacts = contactManifold->getNumContacts();
+		return;
+	}
 
-		if (numContacts > 0)
-		{
-			const btCollisionObject* objA = contactManifold->getBody0();
-			const btCollisionObject* objB = contactManifold->getBody1();
+	std::cout << "collision: hero with enemy" << '\n';
 
-			MeshRenderer* gModA = (MeshRenderer*)objA->getUserPointer();
-			MeshRenderer* gModB = (MeshRenderer*)objB->getUserPointer();
+	btRigidBody* enemyRigidBody = entities->getBody(enemy);
 
-			if ((gModA->name == "hero" && gModB->name == "enemy")
-				|| (gModA->name == "enemy" && gModB->name == "hero"))
-			{
-				printf("collision: %s with %s \n", gModA->name, gModB->name);
-
-				if (gModB->name == "enemy")
-				{
-					btTransform b(gModB->rigidBody->getWorldTransform());
-					b.setOrigin(btVector3(18, 1, 0));
-					gModB->rigidBody->setWorldTransform(b);
-					gModB->rigidBody->getMotionState()->setWorldTransform(b);
-				}
-				else
-				{
-					btTransform a(gModA->rigidBody->getWorldTransform());
-					a.setOrigin(btVector3(18, 1, 0));
-					gModA->rigidBody->setWorldTransform(a);
-					gModA->rigidBody->getMotionState()->setWorldTransform(a);
-				}
-				gameOver = true;
-				score = 0;
-				label->setText("Score: " + std::to_string(score));
-			}
+	btTransform t(enemyRigidBody->getWorldTransform());
+	t.setOrigin(btVector3(18, 1, 0));
+	enemyRigidBody->setWorldTransform(t);
+	enemyRigidBody->getMotionState()->setWorldTransform(t);
 
-			if ((gModA->name == "hero" && gModB->name == "ground")
-				|| (gModA->name == "ground" && gModB->name == "hero"))
-			{
-				printf("collision: %s with %s \n", gModA->name, gModB->name);
+	gameOver = true;
+	score = 0;
+	label->setText("Score: " + std::to_string(score));
+}
 
-				grounded = true;
-			}
-		}
-	}
+void heroGroundContact(const CollisionEvent& event)
+{
+	groundContacts += event.type == kContactBegin ? 1 : -1;
 }
 
 void updateKeyboard(GLFWwindow* window, int key, int scancode, int action,
@@ -320,21 +944,98 @@ void updateKeyboard(GLFWwindow* window, int key, int scancode, int action,
 		glfwSetWindowShouldClose(window, true);
 	}
 
-	if (key == GLFW_KEY_SPACE && action == GLFW_PRESS)
+	if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
 	{
-		if (gameOver)
+		showProfiler = !showProfiler;
+	}
+
+	if (key == GLFW_KEY_F4 && action == GLFW_PRESS)
+	{
+		if (profiler->dump(profileDumpFile))
 		{
-			gameOver = false;
+			std::cout << "Profile written to " << profileDumpFile << '\n';
 		}
 		else
 		{
-			if (grounded == true)
-			{
-				grounded = false;
-				sphere->rigidBody->applyImpulse(btVector3(0.0f, 100.f, 0.0f),
-					btVector3(0.0f, 0.0f, 0.0f));
-				printf("pressed up key \n");
-			}
+			std::cout << "Can't write profile " << profileDumpFile << '\n';
+		}
+	}
+
+	// Everything below is game input, logged so a replay can feed it back
+	if (recorder != NULL)
+	{
+		recorder->addKey(key, action);
+	}
+
+	handleGameKey(key, action);
+}
+
+void handleGameKey(int key, int action)
+{
+	if (key == GLFW_KEY_SPACE && action == GLFW_PRESS)
+	{
+		jump();
+	}
+}
+
+void jump()
+{
+	if (gameOver)
+	{
+		gameOver = false;
+	}
+	else
+	{
+		if (grounded == true)
+		{
+			grounded = false;
+			entities->getBody(hero)->applyImpulse(btVector3(0.0f, 100.f, 0.0f),
+				btVector3(0.0f, 0.0f, 0.0f));
+			printf("pressed up key \n");
+		}
+	}
+}
+
+void addPointLights(int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		float t = (float)i / count;
+
+		// Hues around the colour wheel
+		glm::vec3 color = glm::vec3(
+			0.5f + 0.5f * cosf(6.2832f * t),
+			0.5f + 0.5f * cosf(6.2832f * (t + 0.33f)),
+			0.5f + 0.5f * cosf(6.2832f * (t + 0.67f)));
+
+		if (lighting->addLight(glm::vec3(0.0f), 4.0f, color) < 0)
+		{
+			std::cout << "Only " << ClusteredLighting::kMaxLights <<
+				" point lights are supported" << '\n';
+			break;
 		}
 	}
-}
\ No newline at end of file
+
+	// Spread over the play area and the stress scene floor behind it
+	updatePointLights(0.0f);
+}
+
+void updatePointLights(float deltaTime)
+{
+	pointLightTime += deltaTime;
+
+	int count	= lighting->getLightCount();
+	int side	= (int)ceilf(sqrtf((float)count));
+
+	// Each light circles its own spot on a grid at its own speed
+	for (int i = 0; i < count; i++)
+	{
+		float x = -30.0f + 60.0f * ((i % side) + 0.5f) / side;
+		float z = -78.0f + 80.0f * ((i / side) + 0.5f) / side;
+
+		float angle = i * 2.4f + pointLightTime * (0.5f + (i % 7) * 0.15f);
+
+		lighting->setLightPosition(i, glm::vec3(x + 1.5f * cosf(angle), 1.5f,
+			z + 1.5f * sinf(angle)));
+	}
+}
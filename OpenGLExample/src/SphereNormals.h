@@ -0,0 +1,470 @@
+#pragma once
+
+// Unit normals of the default sphere, kSphereBands + 1 latitude bands of
+// kSphereBands + 1 vertices each, in the order setSphereData() emits them.
+// Generated offline in double precision and rounded to float, regenerate it
+// when kSphereBands changes.
+static constexpr float kSphereNormals[][3] = {
+	// latitude band 0
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+	// latitude band 1
+	{ 0.156434461f, 0.987688363f, 0.0f },
+	{ 0.148778021f, 0.987688363f, 0.0483409092f },
+	{ 0.12655814f, 0.987688363f, 0.0919498727f },
+	{ 0.0919498727f, 0.987688363f, 0.12655814f },
+	{ 0.0483409092f, 0.987688363f, 0.148778021f },
+	{ 9.57884827e-18f, 0.987688363f, 0.156434461f },
+	{ -0.0483409092f, 0.987688363f, 0.148778021f },
+	{ -0.0919498727f, 0.987688363f, 0.12655814f },
+	{ -0.12655814f, 0.987688363f, 0.0919498727f },
+	{ -0.148778021f, 0.987688363f, 0.0483409092f },
+	{ -0.156434461f, 0.987688363f, 1.91576965e-17f },
+	{ -0.148778021f, 0.987688363f, -0.0483409092f },
+	{ -0.12655814f, 0.987688363f, -0.0919498727f },
+	{ -0.0919498727f, 0.987688363f, -0.12655814f },
+	{ -0.0483409092f, 0.987688363f, -0.148778021f },
+	{ -2.87365456e-17f, 0.987688363f, -0.156434461f },
+	{ 0.0483409092f, 0.987688363f, -0.148778021f },
+	{ 0.0919498727f, 0.987688363f, -0.12655814f },
+	{ 0.12655814f, 0.987688363f, -0.0919498727f },
+	{ 0.148778021f, 0.987688363f, -0.0483409092f },
+	{ 0.156434461f, 0.987688363f, -3.83153931e-17f },
+	// latitude band 2
+	{ 0.309017003f, 0.95105654f, 0.0f },
+	{ 0.293892622f, 0.95105654f, 0.0954915062f },
+	{ 0.25f, 0.95105654f, 0.181635633f },
+	{ 0.181635633f, 0.95105654f, 0.25f },
+	{ 0.0954915062f, 0.95105654f, 0.293892622f },
+	{ 1.89218343e-17f, 0.95105654f, 0.309017003f },
+	{ -0.0954915062f, 0.95105654f, 0.293892622f },
+	{ -0.181635633f, 0.95105654f, 0.25f },
+	{ -0.25f, 0.95105654f, 0.181635633f },
+	{ -0.293892622f, 0.95105654f, 0.0954915062f },
+	{ -0.309017003f, 0.95105654f, 3.78436685e-17f },
+	{ -0.293892622f, 0.95105654f, -0.0954915062f },
+	{ -0.25f, 0.95105654f, -0.181635633f },
+	{ -0.181635633f, 0.95105654f, -0.25f },
+	{ -0.0954915062f, 0.95105654f, -0.293892622f },
+	{ -5.67655011e-17f, 0.95105654f, -0.309017003f },
+	{ 0.0954915062f, 0.95105654f, -0.293892622f },
+	{ 0.181635633f, 0.95105654f, -0.25f },
+	{ 0.25f, 0.95105654f, -0.181635633f },
+	{ 0.293892622f, 0.95105654f, -0.0954915062f },
+	{ 0.309017003f, 0.95105654f, -7.56873371e-17f },
+	// latitude band 3
+	{ 0.453990489f, 0.891006529f, 0.0f },
+	{ 0.431770623f, 0.891006529f, 0.140290782f },
+	{ 0.367286026f, 0.891006529f, 0.266848922f },
+	{ 0.266848922f, 0.891006529f, 0.367286026f },
+	{ 0.140290782f, 0.891006529f, 0.431770623f },
+	{ 2.77989e-17f, 0.891006529f, 0.453990489f },
+	{ -0.140290782f, 0.891006529f, 0.431770623f },
+	{ -0.266848922f, 0.891006529f, 0.367286026f },
+	{ -0.367286026f, 0.891006529f, 0.266848922f },
+	{ -0.431770623f, 0.891006529f, 0.140290782f },
+	{ -0.453990489f, 0.891006529f, 5.55978001e-17f },
+	{ -0.431770623f, 0.891006529f, -0.140290782f },
+	{ -0.367286026f, 0.891006529f, -0.266848922f },
+	{ -0.266848922f, 0.891006529f, -0.367286026f },
+	{ -0.140290782f, 0.891006529f, -0.431770623f },
+	{ -8.33967001e-17f, 0.891006529f, -0.453990489f },
+	{ 0.140290782f, 0.891006529f, -0.431770623f },
+	{ 0.266848922f, 0.891006529f, -0.367286026f },
+	{ 0.367286026f, 0.891006529f, -0.266848922f },
+	{ 0.431770623f, 0.891006529f, -0.140290782f },
+	{ 0.453990489f, 0.891006529f, -1.111956e-16f },
+	// latitude band 4
+	{ 0.587785244f, 0.809017003f, 0.0f },
+	{ 0.559017003f, 0.809017003f, 0.181635633f },
+	{ 0.47552827f, 0.809017003f, 0.345491499f },
+	{ 0.345491499f, 0.809017003f, 0.47552827f },
+	{ 0.181635633f, 0.809017003f, 0.559017003f },
+	{ 3.59914656e-17f, 0.809017003f, 0.587785244f },
+	{ -0.181635633f, 0.809017003f, 0.559017003f },
+	{ -0.345491499f, 0.809017003f, 0.47552827f },
+	{ -0.47552827f, 0.809017003f, 0.345491499f },
+	{ -0.559017003f, 0.809017003f, 0.181635633f },
+	{ -0.587785244f, 0.809017003f, 7.19829311e-17f },
+	{ -0.559017003f, 0.809017003f, -0.181635633f },
+	{ -0.47552827f, 0.809017003f, -0.345491499f },
+	{ -0.345491499f, 0.809017003f, -0.47552827f },
+	{ -0.181635633f, 0.809017003f, -0.559017003f },
+	{ -1.079744e-16f, 0.809017003f, -0.587785244f },
+	{ 0.181635633f, 0.809017003f, -0.559017003f },
+	{ 0.345491499f, 0.809017003f, -0.47552827f },
+	{ 0.47552827f, 0.809017003f, -0.345491499f },
+	{ 0.559017003f, 0.809017003f, -0.181635633f },
+	{ 0.587785244f, 0.809017003f, -1.43965862e-16f },
+	// latitude band 5
+	{ 0.707106769f, 0.707106769f, 0.0f },
+	{ 0.672498524f, 0.707106769f, 0.218508005f },
+	{ 0.572061419f, 0.707106769f, 0.415626943f },
+	{ 0.415626943f, 0.707106769f, 0.572061419f },
+	{ 0.218508005f, 0.707106769f, 0.672498524f },
+	{ 4.3297803e-17f, 0.707106769f, 0.707106769f },
+	{ -0.218508005f, 0.707106769f, 0.672498524f },
+	{ -0.415626943f, 0.707106769f, 0.572061419f },
+	{ -0.572061419f, 0.707106769f, 0.415626943f },
+	{ -0.672498524f, 0.707106769f, 0.218508005f },
+	{ -0.707106769f, 0.707106769f, 8.6595606e-17f },
+	{ -0.672498524f, 0.707106769f, -0.218508005f },
+	{ -0.572061419f, 0.707106769f, -0.415626943f },
+	{ -0.415626943f, 0.707106769f, -0.572061419f },
+	{ -0.218508005f, 0.707106769f, -0.672498524f },
+	{ -1.29893402e-16f, 0.707106769f, -0.707106769f },
+	{ 0.218508005f, 0.707106769f, -0.672498524f },
+	{ 0.415626943f, 0.707106769f, -0.572061419f },
+	{ 0.572061419f, 0.707106769f, -0.415626943f },
+	{ 0.672498524f, 0.707106769f, -0.218508005f },
+	{ 0.707106769f, 0.707106769f, -1.73191212e-16f },
+	// latitude band 6
+	{ 0.809017003f, 0.587785244f, 0.0f },
+	{ 0.769420862f, 0.587785244f, 0.25f },
+	{ 0.654508471f, 0.587785244f, 0.47552827f },
+	{ 0.47552827f, 0.587785244f, 0.654508471f },
+	{ 0.25f, 0.587785244f, 0.769420862f },
+	{ 4.95380039e-17f, 0.587785244f, 0.809017003f },
+	{ -0.25f, 0.587785244f, 0.769420862f },
+	{ -0.47552827f, 0.587785244f, 0.654508471f },
+	{ -0.654508471f, 0.587785244f, 0.47552827f },
+	{ -0.769420862f, 0.587785244f, 0.25f },
+	{ -0.809017003f, 0.587785244f, 9.90760079e-17f },
+	{ -0.769420862f, 0.587785244f, -0.25f },
+	{ -0.654508471f, 0.587785244f, -0.47552827f },
+	{ -0.47552827f, 0.587785244f, -0.654508471f },
+	{ -0.25f, 0.587785244f, -0.769420862f },
+	{ -1.48614008e-16f, 0.587785244f, -0.809017003f },
+	{ 0.25f, 0.587785244f, -0.769420862f },
+	{ 0.47552827f, 0.587785244f, -0.654508471f },
+	{ 0.654508471f, 0.587785244f, -0.47552827f },
+	{ 0.769420862f, 0.587785244f, -0.25f },
+	{ 0.809017003f, 0.587785244f, -1.98152016e-16f },
+	// latitude band 7
+	{ 0.891006529f, 0.453990489f, 0.0f },
+	{ 0.847397566f, 0.453990489f, 0.275336146f },
+	{ 0.720839441f, 0.453990489f, 0.523720503f },
+	{ 0.523720503f, 0.453990489f, 0.720839441f },
+	{ 0.275336146f, 0.453990489f, 0.847397566f },
+	{ 5.45584145e-17f, 0.453990489f, 0.891006529f },
+	{ -0.275336146f, 0.453990489f, 0.847397566f },
+	{ -0.523720503f, 0.453990489f, 0.720839441f },
+	{ -0.720839441f, 0.453990489f, 0.523720503f },
+	{ -0.847397566f, 0.453990489f, 0.275336146f },
+	{ -0.891006529f, 0.453990489f, 1.09116829e-16f },
+	{ -0.847397566f, 0.453990489f, -0.275336146f },
+	{ -0.720839441f, 0.453990489f, -0.523720503f },
+	{ -0.523720503f, 0.453990489f, -0.720839441f },
+	{ -0.275336146f, 0.453990489f, -0.847397566f },
+	{ -1.63675247e-16f, 0.453990489f, -0.891006529f },
+	{ 0.275336146f, 0.453990489f, -0.847397566f },
+	{ 0.523720503f, 0.453990489f, -0.720839441f },
+	{ 0.720839441f, 0.453990489f, -0.523720503f },
+	{ 0.847397566f, 0.453990489f, -0.275336146f },
+	{ 0.891006529f, 0.453990489f, -2.18233658e-16f },
+	// latitude band 8
+	{ 0.95105654f, 0.309017003f, 0.0f },
+	{ 0.904508471f, 0.309017003f, 0.293892622f },
+	{ 0.769420862f, 0.309017003f, 0.559017003f },
+	{ 0.559017003f, 0.309017003f, 0.769420862f },
+	{ 0.293892622f, 0.309017003f, 0.904508471f },
+	{ 5.82354143e-17f, 0.309017003f, 0.95105654f },
+	{ -0.293892622f, 0.309017003f, 0.904508471f },
+	{ -0.559017003f, 0.309017003f, 0.769420862f },
+	{ -0.769420862f, 0.309017003f, 0.559017003f },
+	{ -0.904508471f, 0.309017003f, 0.293892622f },
+	{ -0.95105654f, 0.309017003f, 1.16470829e-16f },
+	{ -0.904508471f, 0.309017003f, -0.293892622f },
+	{ -0.769420862f, 0.309017003f, -0.559017003f },
+	{ -0.559017003f, 0.309017003f, -0.769420862f },
+	{ -0.293892622f, 0.309017003f, -0.904508471f },
+	{ -1.7470625e-16f, 0.309017003f, -0.95105654f },
+	{ 0.293892622f, 0.309017003f, -0.904508471f },
+	{ 0.559017003f, 0.309017003f, -0.769420862f },
+	{ 0.769420862f, 0.309017003f, -0.559017003f },
+	{ 0.904508471f, 0.309017003f, -0.293892622f },
+	{ 0.95105654f, 0.309017003f, -2.32941657e-16f },
+	// latitude band 9
+	{ 0.987688363f, 0.156434461f, 0.0f },
+	{ 0.939347446f, 0.156434461f, 0.305212468f },
+	{ 0.799056649f, 0.156434461f, 0.580548644f },
+	{ 0.580548644f, 0.156434461f, 0.799056649f },
+	{ 0.305212468f, 0.156434461f, 0.939347446f },
+	{ 6.04784701e-17f, 0.156434461f, 0.987688363f },
+	{ -0.305212468f, 0.156434461f, 0.939347446f },
+	{ -0.580548644f, 0.156434461f, 0.799056649f },
+	{ -0.799056649f, 0.156434461f, 0.580548644f },
+	{ -0.939347446f, 0.156434461f, 0.305212468f },
+	{ -0.987688363f, 0.156434461f, 1.2095694e-16f },
+	{ -0.939347446f, 0.156434461f, -0.305212468f },
+	{ -0.799056649f, 0.156434461f, -0.580548644f },
+	{ -0.580548644f, 0.156434461f, -0.799056649f },
+	{ -0.305212468f, 0.156434461f, -0.939347446f },
+	{ -1.8143541e-16f, 0.156434461f, -0.987688363f },
+	{ 0.305212468f, 0.156434461f, -0.939347446f },
+	{ 0.580548644f, 0.156434461f, -0.799056649f },
+	{ 0.799056649f, 0.156434461f, -0.580548644f },
+	{ 0.939347446f, 0.156434461f, -0.305212468f },
+	{ 0.987688363f, 0.156434461f, -2.4191388e-16f },
+	// latitude band 10
+	{ 1.0f, 6.12323426e-17f, 0.0f },
+	{ 0.95105654f, 6.12323426e-17f, 0.309017003f },
+	{ 0.809017003f, 6.12323426e-17f, 0.587785244f },
+	{ 0.587785244f, 6.12323426e-17f, 0.809017003f },
+	{ 0.309017003f, 6.12323426e-17f, 0.95105654f },
+	{ 6.12323426e-17f, 6.12323426e-17f, 1.0f },
+	{ -0.309017003f, 6.12323426e-17f, 0.95105654f },
+	{ -0.587785244f, 6.12323426e-17f, 0.809017003f },
+	{ -0.809017003f, 6.12323426e-17f, 0.587785244f },
+	{ -0.95105654f, 6.12323426e-17f, 0.309017003f },
+	{ -1.0f, 6.12323426e-17f, 1.22464685e-16f },
+	{ -0.95105654f, 6.12323426e-17f, -0.309017003f },
+	{ -0.809017003f, 6.12323426e-17f, -0.587785244f },
+	{ -0.587785244f, 6.12323426e-17f, -0.809017003f },
+	{ -0.309017003f, 6.12323426e-17f, -0.95105654f },
+	{ -1.83697015e-16f, 6.12323426e-17f, -1.0f },
+	{ 0.309017003f, 6.12323426e-17f, -0.95105654f },
+	{ 0.587785244f, 6.12323426e-17f, -0.809017003f },
+	{ 0.809017003f, 6.12323426e-17f, -0.587785244f },
+	{ 0.95105654f, 6.12323426e-17f, -0.309017003f },
+	{ 1.0f, 6.12323426e-17f, -2.44929371e-16f },
+	// latitude band 11
+	{ 0.987688363f, -0.156434461f, 0.0f },
+	{ 0.939347446f, -0.156434461f, 0.305212468f },
+	{ 0.799056649f, -0.156434461f, 0.580548644f },
+	{ 0.580548644f, -0.156434461f, 0.799056649f },
+	{ 0.305212468f, -0.156434461f, 0.939347446f },
+	{ 6.04784701e-17f, -0.156434461f, 0.987688363f },
+	{ -0.305212468f, -0.156434461f, 0.939347446f },
+	{ -0.580548644f, -0.156434461f, 0.799056649f },
+	{ -0.799056649f, -0.156434461f, 0.580548644f },
+	{ -0.939347446f, -0.156434461f, 0.305212468f },
+	{ -0.987688363f, -0.156434461f, 1.2095694e-16f },
+	{ -0.939347446f, -0.156434461f, -0.305212468f },
+	{ -0.799056649f, -0.156434461f, -0.580548644f },
+	{ -0.580548644f, -0.156434461f, -0.799056649f },
+	{ -0.305212468f, -0.156434461f, -0.939347446f },
+	{ -1.8143541e-16f, -0.156434461f, -0.987688363f },
+	{ 0.305212468f, -0.156434461f, -0.939347446f },
+	{ 0.580548644f, -0.156434461f, -0.799056649f },
+	{ 0.799056649f, -0.156434461f, -0.580548644f },
+	{ 0.939347446f, -0.156434461f, -0.305212468f },
+	{ 0.987688363f, -0.156434461f, -2.4191388e-16f },
+	// latitude band 12
+	{ 0.95105654f, -0.309017003f, 0.0f },
+	{ 0.904508471f, -0.309017003f, 0.293892622f },
+	{ 0.769420862f, -0.309017003f, 0.559017003f },
+	{ 0.559017003f, -0.309017003f, 0.769420862f },
+	{ 0.293892622f, -0.309017003f, 0.904508471f },
+	{ 5.82354143e-17f, -0.309017003f, 0.95105654f },
+	{ -0.293892622f, -0.309017003f, 0.904508471f },
+	{ -0.559017003f, -0.309017003f, 0.769420862f },
+	{ -0.769420862f, -0.309017003f, 0.559017003f },
+	{ -0.904508471f, -0.309017003f, 0.293892622f },
+	{ -0.95105654f, -0.309017003f, 1.16470829e-16f },
+	{ -0.904508471f, -0.309017003f, -0.293892622f },
+	{ -0.769420862f, -0.309017003f, -0.559017003f },
+	{ -0.559017003f, -0.309017003f, -0.769420862f },
+	{ -0.293892622f, -0.309017003f, -0.904508471f },
+	{ -1.7470625e-16f, -0.309017003f, -0.95105654f },
+	{ 0.293892622f, -0.309017003f, -0.904508471f },
+	{ 0.559017003f, -0.309017003f, -0.769420862f },
+	{ 0.769420862f, -0.309017003f, -0.559017003f },
+	{ 0.904508471f, -0.309017003f, -0.293892622f },
+	{ 0.95105654f, -0.309017003f, -2.32941657e-16f },
+	// latitude band 13
+	{ 0.891006529f, -0.453990489f, 0.0f },
+	{ 0.847397566f, -0.453990489f, 0.275336146f },
+	{ 0.720839441f, -0.453990489f, 0.523720503f },
+	{ 0.523720503f, -0.453990489f, 0.720839441f },
+	{ 0.275336146f, -0.453990489f, 0.847397566f },
+	{ 5.45584145e-17f, -0.453990489f, 0.891006529f },
+	{ -0.275336146f, -0.453990489f, 0.847397566f },
+	{ -0.523720503f, -0.453990489f, 0.720839441f },
+	{ -0.720839441f, -0.453990489f, 0.523720503f },
+	{ -0.847397566f, -0.453990489f, 0.275336146f },
+	{ -0.891006529f, -0.453990489f, 1.09116829e-16f },
+	{ -0.847397566f, -0.453990489f, -0.275336146f },
+	{ -0.720839441f, -0.453990489f, -0.523720503f },
+	{ -0.523720503f, -0.453990489f, -0.720839441f },
+	{ -0.275336146f, -0.453990489f, -0.847397566f },
+	{ -1.63675247e-16f, -0.453990489f, -0.891006529f },
+	{ 0.275336146f, -0.453990489f, -0.847397566f },
+	{ 0.523720503f, -0.453990489f, -0.720839441f },
+	{ 0.720839441f, -0.453990489f, -0.523720503f },
+	{ 0.847397566f, -0.453990489f, -0.275336146f },
+	{ 0.891006529f, -0.453990489f, -2.18233658e-16f },
+	// latitude band 14
+	{ 0.809017003f, -0.587785244f, 0.0f },
+	{ 0.769420862f, -0.587785244f, 0.25f },
+	{ 0.654508471f, -0.587785244f, 0.47552827f },
+	{ 0.47552827f, -0.587785244f, 0.654508471f },
+	{ 0.25f, -0.587785244f, 0.769420862f },
+	{ 4.95380039e-17f, -0.587785244f, 0.809017003f },
+	{ -0.25f, -0.587785244f, 0.769420862f },
+	{ -0.47552827f, -0.587785244f, 0.654508471f },
+	{ -0.654508471f, -0.587785244f, 0.47552827f },
+	{ -0.769420862f, -0.587785244f, 0.25f },
+	{ -0.809017003f, -0.587785244f, 9.90760079e-17f },
+	{ -0.769420862f, -0.587785244f, -0.25f },
+	{ -0.654508471f, -0.587785244f, -0.47552827f },
+	{ -0.47552827f, -0.587785244f, -0.654508471f },
+	{ -0.25f, -0.587785244f, -0.769420862f },
+	{ -1.48614008e-16f, -0.587785244f, -0.809017003f },
+	{ 0.25f, -0.587785244f, -0.769420862f },
+	{ 0.47552827f, -0.587785244f, -0.654508471f },
+	{ 0.654508471f, -0.587785244f, -0.47552827f },
+	{ 0.769420862f, -0.587785244f, -0.25f },
+	{ 0.809017003f, -0.587785244f, -1.98152016e-16f },
+	// latitude band 15
+	{ 0.707106769f, -0.707106769f, 0.0f },
+	{ 0.672498524f, -0.707106769f, 0.218508005f },
+	{ 0.572061419f, -0.707106769f, 0.415626943f },
+	{ 0.415626943f, -0.707106769f, 0.572061419f },
+	{ 0.218508005f, -0.707106769f, 0.672498524f },
+	{ 4.3297803e-17f, -0.707106769f, 0.707106769f },
+	{ -0.218508005f, -0.707106769f, 0.672498524f },
+	{ -0.415626943f, -0.707106769f, 0.572061419f },
+	{ -0.572061419f, -0.707106769f, 0.415626943f },
+	{ -0.672498524f, -0.707106769f, 0.218508005f },
+	{ -0.707106769f, -0.707106769f, 8.6595606e-17f },
+	{ -0.672498524f, -0.707106769f, -0.218508005f },
+	{ -0.572061419f, -0.707106769f, -0.415626943f },
+	{ -0.415626943f, -0.707106769f, -0.572061419f },
+	{ -0.218508005f, -0.707106769f, -0.672498524f },
+	{ -1.29893402e-16f, -0.707106769f, -0.707106769f },
+	{ 0.218508005f, -0.707106769f, -0.672498524f },
+	{ 0.415626943f, -0.707106769f, -0.572061419f },
+	{ 0.572061419f, -0.707106769f, -0.415626943f },
+	{ 0.672498524f, -0.707106769f, -0.218508005f },
+	{ 0.707106769f, -0.707106769f, -1.73191212e-16f },
+	// latitude band 16
+	{ 0.587785244f, -0.809017003f, 0.0f },
+	{ 0.559017003f, -0.809017003f, 0.181635633f },
+	{ 0.47552827f, -0.809017003f, 0.345491499f },
+	{ 0.345491499f, -0.809017003f, 0.47552827f },
+	{ 0.181635633f, -0.809017003f, 0.559017003f },
+	{ 3.59914656e-17f, -0.809017003f, 0.587785244f },
+	{ -0.181635633f, -0.809017003f, 0.559017003f },
+	{ -0.345491499f, -0.809017003f, 0.47552827f },
+	{ -0.47552827f, -0.809017003f, 0.345491499f },
+	{ -0.559017003f, -0.809017003f, 0.181635633f },
+	{ -0.587785244f, -0.809017003f, 7.19829311e-17f },
+	{ -0.559017003f, -0.809017003f, -0.181635633f },
+	{ -0.47552827f, -0.809017003f, -0.345491499f },
+	{ -0.345491499f, -0.809017003f, -0.47552827f },
+	{ -0.181635633f, -0.809017003f, -0.559017003f },
+	{ -1.079744e-16f, -0.809017003f, -0.587785244f },
+	{ 0.181635633f, -0.809017003f, -0.559017003f },
+	{ 0.345491499f, -0.809017003f, -0.47552827f },
+	{ 0.47552827f, -0.809017003f, -0.345491499f },
+	{ 0.559017003f, -0.809017003f, -0.181635633f },
+	{ 0.587785244f, -0.809017003f, -1.43965862e-16f },
+	// latitude band 17
+	{ 0.453990489f, -0.891006529f, 0.0f },
+	{ 0.431770623f, -0.891006529f, 0.140290782f },
+	{ 0.367286026f, -0.891006529f, 0.266848922f },
+	{ 0.266848922f, -0.891006529f, 0.367286026f },
+	{ 0.140290782f, -0.891006529f, 0.431770623f },
+	{ 2.77989e-17f, -0.891006529f, 0.453990489f },
+	{ -0.140290782f, -0.891006529f, 0.431770623f },
+	{ -0.266848922f, -0.891006529f, 0.367286026f },
+	{ -0.367286026f, -0.891006529f, 0.266848922f },
+	{ -0.431770623f, -0.891006529f, 0.140290782f },
+	{ -0.453990489f, -0.891006529f, 5.55978001e-17f },
+	{ -0.431770623f, -0.891006529f, -0.140290782f },
+	{ -0.367286026f, -0.891006529f, -0.266848922f },
+	{ -0.266848922f, -0.891006529f, -0.367286026f },
+	{ -0.140290782f, -0.891006529f, -0.431770623f },
+	{ -8.33967001e-17f, -0.891006529f, -0.453990489f },
+	{ 0.140290782f, -0.891006529f, -0.431770623f },
+	{ 0.266848922f, -0.891006529f, -0.367286026f },
+	{ 0.367286026f, -0.891006529f, -0.266848922f },
+	{ 0.431770623f, -0.891006529f, -0.140290782f },
+	{ 0.453990489f, -0.891006529f, -1.111956e-16f },
+	// latitude band 18
+	{ 0.309017003f, -0.95105654f, 0.0f },
+	{ 0.293892622f, -0.95105654f, 0.0954915062f },
+	{ 0.25f, -0.95105654f, 0.181635633f },
+	{ 0.181635633f, -0.95105654f, 0.25f },
+	{ 0.0954915062f, -0.95105654f, 0.293892622f },
+	{ 1.89218343e-17f, -0.95105654f, 0.309017003f },
+	{ -0.0954915062f, -0.95105654f, 0.293892622f },
+	{ -0.181635633f, -0.95105654f, 0.25f },
+	{ -0.25f, -0.95105654f, 0.181635633f },
+	{ -0.293892622f, -0.95105654f, 0.0954915062f },
+	{ -0.309017003f, -0.95105654f, 3.78436685e-17f },
+	{ -0.293892622f, -0.95105654f, -0.0954915062f },
+	{ -0.25f, -0.95105654f, -0.181635633f },
+	{ -0.181635633f, -0.95105654f, -0.25f },
+	{ -0.0954915062f, -0.95105654f, -0.293892622f },
+	{ -5.67655011e-17f, -0.95105654f, -0.309017003f },
+	{ 0.0954915062f, -0.95105654f, -0.293892622f },
+	{ 0.181635633f, -0.95105654f, -0.25f },
+	{ 0.25f, -0.95105654f, -0.181635633f },
+	{ 0.293892622f, -0.95105654f, -0.0954915062f },
+	{ 0.309017003f, -0.95105654f, -7.56873371e-17f },
+	// latitude band 19
+	{ 0.156434461f, -0.987688363f, 0.0f },
+	{ 0.148778021f, -0.987688363f, 0.0483409092f },
+	{ 0.12655814f, -0.987688363f, 0.0919498727f },
+	{ 0.0919498727f, -0.987688363f, 0.12655814f },
+	{ 0.0483409092f, -0.987688363f, 0.148778021f },
+	{ 9.57884827e-18f, -0.987688363f, 0.156434461f },
+	{ -0.0483409092f, -0.987688363f, 0.148778021f },
+	{ -0.0919498727f, -0.987688363f, 0.12655814f },
+	{ -0.12655814f, -0.987688363f, 0.0919498727f },
+	{ -0.148778021f, -0.987688363f, 0.0483409092f },
+	{ -0.156434461f, -0.987688363f, 1.91576965e-17f },
+	{ -0.148778021f, -0.987688363f, -0.0483409092f },
+	{ -0.12655814f, -0.987688363f, -0.0919498727f },
+	{ -0.0919498727f, -0.987688363f, -0.12655814f },
+	{ -0.0483409092f, -0.987688363f, -0.148778021f },
+	{ -2.87365456e-17f, -0.987688363f, -0.156434461f },
+	{ 0.0483409092f, -0.987688363f, -0.148778021f },
+	{ 0.0919498727f, -0.987688363f, -0.12655814f },
+	{ 0.12655814f, -0.987688363f, -0.0919498727f },
+	{ 0.148778021f, -0.987688363f, -0.0483409092f },
+	{ 0.156434461f, -0.987688363f, -3.83153931e-17f },
+	// latitude band 20
+	{ 1.22464685e-16f, -1.0f, 0.0f },
+	{ 1.16470829e-16f, -1.0f, 3.78436685e-17f },
+	{ 9.90760079e-17f, -1.0f, 7.19829311e-17f },
+	{ 7.19829311e-17f, -1.0f, 9.90760079e-17f },
+	{ 3.78436685e-17f, -1.0f, 1.16470829e-16f },
+	{ 7.49879879e-33f, -1.0f, 1.22464685e-16f },
+	{ -3.78436685e-17f, -1.0f, 1.16470829e-16f },
+	{ -7.19829311e-17f, -1.0f, 9.90760079e-17f },
+	{ -9.90760079e-17f, -1.0f, 7.19829311e-17f },
+	{ -1.16470829e-16f, -1.0f, 3.78436685e-17f },
+	{ -1.22464685e-16f, -1.0f, 1.49975976e-32f },
+	{ -1.16470829e-16f, -1.0f, -3.78436685e-17f },
+	{ -9.90760079e-17f, -1.0f, -7.19829311e-17f },
+	{ -7.19829311e-17f, -1.0f, -9.90760079e-17f },
+	{ -3.78436685e-17f, -1.0f, -1.16470829e-16f },
+	{ -2.24963964e-32f, -1.0f, -1.22464685e-16f },
+	{ 3.78436685e-17f, -1.0f, -1.16470829e-16f },
+	{ 7.19829311e-17f, -1.0f, -9.90760079e-17f },
+	{ 9.90760079e-17f, -1.0f, -7.19829311e-17f },
+	{ 1.16470829e-16f, -1.0f, -3.78436685e-17f },
+	{ 1.22464685e-16f, -1.0f, -2.99951951e-32f },
+};
@@ -0,0 +1,141 @@
+#include "StreamBuffer.h"
+
+StreamBuffer::StreamBuffer(GLsizeiptr inFrameSize)
+{
+	frameSize	= inFrameSize;
+	frame		= kStreamFrameCount - 1;	// beginFrame() moves to 0
+	used		= 0;
+	flushed		= 0;
+	persistent	= GLEW_ARB_buffer_storage;
+	mapped		= NULL;
+
+	for (GLsync& fence : fences)
+	{
+		fence = 0;
+	}
+
+	// The copy target leaves every binding the renderers use alone
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+	if (persistent)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+			GL_MAP_COHERENT_BIT;
+
+		glBufferStorage(GL_COPY_WRITE_BUFFER, frameSize * kStreamFrameCount,
+			NULL, flags);
+		mapped = (unsigned char*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0,
+			frameSize * kStreamFrameCount, flags);
+	}
+	else
+	{
+		glBufferData(GL_COPY_WRITE_BUFFER, frameSize * kStreamFrameCount, NULL,
+			GL_STREAM_DRAW);
+		staging.resize(frameSize);
+	}
+
+	// unbind
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	for (GLsync fence : fences)
+	{
+		if (fence != 0)
+		{
+			glDeleteSync(fence);
+		}
+	}
+
+	// Deleting the buffer also unmaps it
+	glDeleteBuffers(1, &buffer);
+}
+
+void StreamBuffer::beginFrame()
+{
+	frame	= (frame + 1) % kStreamFrameCount;
+	used	= 0;
+	flushed	= 0;
+
+	GLsync& fence = fences[frame];
+
+	if (fence == 0)
+	{
+		return;
+	}
+
+	// Normally signalled long ago, kStreamFrameCount - 1 frames have passed
+	while (true)
+	{
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+			1000000);
+
+		if (result != GL_TIMEOUT_EXPIRED)
+		{
+			break;
+		}
+	}
+
+	glDeleteSync(fence);
+	fence = 0;
+}
+
+void* StreamBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment,
+	GLintptr* offset)
+{
+	GLsizeiptr frameStart = frameSize * frame;
+
+	// Align from the start of the buffer, callers turn offsets into indices
+	GLsizeiptr start = frameStart + used;
+	start = (start + alignment - 1) / alignment * alignment;
+
+	if (start + size > frameStart + frameSize)
+	{
+		return NULL;
+	}
+
+	used	= start + size - frameStart;
+	*offset	= start;
+
+	if (persistent)
+	{
+		return mapped + start;
+	}
+
+	return &staging[start - frameStart];
+}
+
+void StreamBuffer::flush()
+{
+	// Coherent mappings are visible to the GPU as they are written
+	if (persistent || used == flushed)
+	{
+		return;
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, frameSize * frame + flushed,
+		used - flushed, &staging[flushed]);
+
+	// unbind
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	flushed = used;
+}
+
+void StreamBuffer::endFrame()
+{
+	fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+GLuint StreamBuffer::getBuffer()
+{
+	return buffer;
+}
+
+bool StreamBuffer::isPersistent()
+{
+	return persistent;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// std
+#include <vector>
+
+// One buffer for everything rewritten every frame, split into
+// kStreamFrameCount partitions used in turn. With ARB_buffer_storage the
+// whole buffer stays mapped persistent and coherent, so callers write
+// straight into GPU visible memory. A fence per partition stops the CPU from
+// overwriting data the GPU is still reading, instead of the driver stalling
+// or copying behind our back. Without the extension writes go to a staging
+// copy that flush() uploads in one glBufferSubData.
+class StreamBuffer
+{
+public:
+	StreamBuffer(GLsizeiptr inFrameSize);
+	~StreamBuffer();
+
+	// Moves to the next partition, waiting for its fence if the GPU has not
+	// finished with it yet
+	void beginFrame();
+
+	// Space for size bytes at an offset from the start of the buffer that is
+	// a multiple of alignment, which need not be a power of two. Returns NULL
+	// when this frame's partition is full.
+	void* allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr* offset);
+
+	// Makes this frame's writes visible to the GPU, call before drawing
+	void flush();
+
+	// Fences the partition once every draw reading it has been issued
+	void endFrame();
+
+	GLuint getBuffer();
+	bool isPersistent();
+
+private:
+
+	static const int kStreamFrameCount = 3;
+
+	GLuint						buffer;
+	GLsizeiptr					frameSize;		// bytes per partition
+	int							frame;			// partition being written
+	GLsizeiptr					used;			// bytes of it handed out
+	GLsizeiptr					flushed;		// bytes of it uploaded
+	GLsync						fences[kStreamFrameCount];
+	bool						persistent;
+	unsigned char*				mapped;			// whole buffer, persistent only
+	std::vector<unsigned char>	staging;		// one partition otherwise
+};
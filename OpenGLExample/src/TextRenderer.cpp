@@ -3,19 +3,18 @@
 
 
 TextRenderer::TextRenderer(std::string inText, std::string inFont, int inSize,
-	glm::vec3 inColor, GLuint inProgram)
+	glm::vec3 inColor, ShaderProgram* inProgram)
 {
 	text	= inText;
 	color	= inColor;
 	scale	= 1.0f;
 	program = inProgram;
-	setPosition(position);
+	vertexCount = 0;
+	setPosition(glm::vec2(0.0f));
 
-	glm::mat4 projection = glm::ortho(0.0f, static_cast<GLfloat>(800), 0.0f,
+	projection = glm::ortho(0.0f, static_cast<GLfloat>(800), 0.0f,
 		static_cast<GLfloat>(600));
-	glUseProgram(program);
-	glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE,
-		glm::value_ptr(projection));
+	projectionSet = false;
 
 	FT_Library ft;
 
@@ -35,11 +34,29 @@ TextRenderer::TextRenderer(std::string inText, std::string inFont, int inSize,
 	// Set size of glyphs
 	FT_Set_Pixel_Sizes(face, 0, inSize);
 
+	// Baseline to baseline distance for '\n'
+	lineHeight = (GLfloat)(face->size->metrics.height >> 6);
+
 	// Disable byte-alignment restriction
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+	// Rasterize every glyph first, then pack them into rows of one atlas
+	// texture. A pixel of padding between glyphs keeps linear filtering from
+	// sampling the neighbours.
+	const int atlasWidth	= 1024;
+	const int padding		= 1;
+
+	std::vector<std::vector<unsigned char>>	bitmaps(128);
+	std::vector<glm::ivec2>					offsets(128);
+
+	int penX		= padding;
+	int penY		= padding;
+	int rowHeight	= 0;
+
 	for (GLubyte i = 0; i < 128; i++)
 	{
+		characters[i] = {};
+
 		// Load character glyph
 		if (FT_Load_Char(face, i, FT_LOAD_RENDER))
 		{
@@ -47,40 +64,75 @@ TextRenderer::TextRenderer(std::string inText, std::string inFont, int inSize,
 			continue;
 		}
 
-		// Generate texture
-		GLuint texture;
-		glGenTextures(1, &texture);
-		glBindTexture(GL_TEXTURE_2D, texture);
-		glTexImage2D(
-			GL_TEXTURE_2D,
-			0,
-			GL_RED,
-			face->glyph->bitmap.width,
-			face->glyph->bitmap.rows,
-			0,
-			GL_RED,
-			GL_UNSIGNED_BYTE,
-			face->glyph->bitmap.buffer);
-
-		// Set texture filtering
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// Create a character
-		Character character = {
-			texture,
-			glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+		FT_Bitmap& bitmap = face->glyph->bitmap;
+
+		if (penX + (int)bitmap.width + padding > atlasWidth)
+		{
+			penX		= padding;
+			penY		+= rowHeight + padding;
+			rowHeight	= 0;
+		}
+
+		offsets[i] = glm::ivec2(penX, penY);
+		bitmaps[i].assign(bitmap.buffer, bitmap.buffer +
+			bitmap.width * bitmap.rows);
+
+		// Create a character, UVs are filled in once the atlas size is known
+		characters[i] = {
+			glm::vec2(0.0f),
+			glm::vec2(0.0f),
+			glm::ivec2(bitmap.width, bitmap.rows),
 			glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-			face->glyph->advance.x
+			(GLuint)face->glyph->advance.x
 		};
 
-		// Store character in characters map
-		characters.insert(std::pair<GLchar, Character>(i, character));
+		penX		+= bitmap.width + padding;
+		rowHeight	= std::max(rowHeight, (int)bitmap.rows);
+	}
+
+	const int atlasHeight = penY + rowHeight + padding;
+
+	std::vector<unsigned char> pixels(atlasWidth * atlasHeight, 0);
+
+	for (int i = 0; i < 128; i++)
+	{
+		Character& ch								= characters[i];
+		const glm::ivec2& offset					= offsets[i];
+		const std::vector<unsigned char>& bitmap	= bitmaps[i];
+
+		for (int row = 0; row < ch.Size.y; row++)
+		{
+			std::copy(bitmap.begin() + row * ch.Size.x,
+				bitmap.begin() + (row + 1) * ch.Size.x,
+				pixels.begin() + (offset.y + row) * atlasWidth + offset.x);
+		}
 
+		ch.UVMin = glm::vec2((float)offset.x / atlasWidth,
+			(float)offset.y / atlasHeight);
+		ch.UVMax = glm::vec2((float)(offset.x + ch.Size.x) / atlasWidth,
+			(float)(offset.y + ch.Size.y) / atlasHeight);
 	}
 
+	// Generate atlas texture
+	glGenTextures(1, &atlas);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	glTexImage2D(
+		GL_TEXTURE_2D,
+		0,
+		GL_R8,
+		atlasWidth,
+		atlasHeight,
+		0,
+		GL_RED,
+		GL_UNSIGNED_BYTE,
+		&pixels[0]);
+
+	// Set texture filtering
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
 	// Unbind
 	glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -93,8 +145,7 @@ TextRenderer::TextRenderer(std::string inText, std::string inFont, int inSize,
 
 	glBindVertexArray(VAO);
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL,
-		GL_DYNAMIC_DRAW);
+	vboSize = 0;
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
 
@@ -105,28 +156,92 @@ TextRenderer::TextRenderer(std::string inText, std::string inFont, int inSize,
 
 TextRenderer::~TextRenderer()
 {
+	glDeleteTextures(1, &atlas);
+	glDeleteBuffers(1, &VBO);
+	glDeleteVertexArrays(1, &VAO);
 }
 
-void TextRenderer::draw()
+void TextRenderer::submit(RenderQueue* queue)
 {
-	glm::vec2 textPos = position;
+	// Layout only runs when the text or position changed
+	if (dirty)
+	{
+		rebuild();
+	}
 
-	glEnable(GL_BLEND);
+	// Program may still be compiling
+	if (vertexCount == 0 || !program->isReady())
+	{
+		return;
+	}
 
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// Set straight on the program, the queue decides when it gets bound
+	if (!projectionSet)
+	{
+		glProgramUniformMatrix4fv(program->getID(),
+			program->getUniformLocation(kUniformProjection), 1, GL_FALSE,
+			glm::value_ptr(projection));
+		projectionSet = true;
+	}
 
-	glUseProgram(program);
-	glUniform3f(glGetUniformLocation(program, "textColor"), color.x, color.y,
-		color.z);
-	glActiveTexture(GL_TEXTURE0);
+	// Colour travels with the packet, labels share the program and the queue
+	// only draws after every label has submitted
+	DrawPacket packet;
+	packet.pass		= kPassOverlay;
+	packet.program	= program;
+	packet.texture	= atlas;
+	packet.vao		= VAO;
+	packet.type		= kDrawArrays;
+	packet.count	= vertexCount;
+	packet.hasColor	= true;
+	packet.color	= color;
+
+	queue->submit(packet);
+}
 
-	glBindVertexArray(VAO);
+void TextRenderer::setPosition(glm::vec2 inPosition)
+{
+	position	= inPosition;
+	dirty		= true;
+}
+
+void TextRenderer::setText(std::string inText)
+{
+	if (inText != text)
+	{
+		text	= inText;
+		dirty	= true;
+	}
+}
+
+void TextRenderer::rebuild()
+{
+	glm::vec2 textPos = position;
+
+	// Build the quads for the whole string into GPU memory that is reused
+	// every frame until the text changes again
+	std::vector<glm::vec4> vertices;	// <vec2 pos, vec2 tex>, 6 per glyph
+	vertices.reserve(text.size() * 6);
 
 	std::string::const_iterator c;
 	
 	for (c = text.begin(); c != text.end(); c++)
 	{
-		Character ch = characters[*c];
+		GLubyte code = (GLubyte)*c;
+
+		if (code == '\n')
+		{
+			textPos.x = position.x;
+			textPos.y -= lineHeight * scale;
+			continue;
+		}
+
+		if (code >= 128)
+		{
+			continue;
+		}
+
+		const Character& ch = characters[code];
 
 		GLfloat xpos = textPos.x + ch.Bearing.x * scale;
 		GLfloat ypos = textPos.y - (ch.Size.y - ch.Bearing.y) * scale;
@@ -134,47 +249,40 @@ void TextRenderer::draw()
 		GLfloat w = ch.Size.x * scale;
 		GLfloat h = ch.Size.y * scale;
 
-		// Per character update VBO
-		GLfloat vertices[6][4] = {
-			{ xpos, ypos + h, 0.0, 0.0 },
-			{ xpos, ypos, 0.0, 1.0 },
-			{ xpos + w, ypos, 1.0, 1.0 },
-
-			{ xpos, ypos + h, 0.0, 0.0 },
-			{ xpos + w, ypos, 1.0, 1.0 },
-			{ xpos + w, ypos + h, 1.0, 0.0 }
-		};
+		vertices.push_back(glm::vec4(xpos, ypos + h, ch.UVMin.x, ch.UVMin.y));
+		vertices.push_back(glm::vec4(xpos, ypos, ch.UVMin.x, ch.UVMax.y));
+		vertices.push_back(glm::vec4(xpos + w, ypos, ch.UVMax.x, ch.UVMax.y));
 
-		// Render glyph texture over quad
-		glBindTexture(GL_TEXTURE_2D, ch.TextureID);
-		// Update content of VBO memory
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		// Use glBufferSubData and not glBufferData
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+		vertices.push_back(glm::vec4(xpos, ypos + h, ch.UVMin.x, ch.UVMin.y));
+		vertices.push_back(glm::vec4(xpos + w, ypos, ch.UVMax.x, ch.UVMax.y));
+		vertices.push_back(glm::vec4(xpos + w, ypos + h, ch.UVMax.x, ch.UVMin.y));
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		// Render Quad
-		glDrawArrays(GL_TRIANGLES, 0, 6);
 		// Now advance cursors for next glyph (note that advance is number of 
 		// 1/64 pixels
 		// Bitshift by 6 to get value in pixels (2^6 = 64 (divide amout of 
 		// 1/64th pixels by 64 to get amount of pixels))
 		textPos.x += (ch.Advance >> 6) * scale;
+	}
+
+	vertexCount = (GLsizei)vertices.size();
+	dirty		= false;
 
+	if (vertices.empty())
+	{
+		return;
 	}
-	// Disable blending
-	glBindVertexArray(0);
-	glBindTexture(GL_TEXTURE_2D, 0);
 
-	glDisable(GL_BLEND);
-}
+	GLsizeiptr size = sizeof(glm::vec4) * vertices.size();
 
-void TextRenderer::setPosition(glm::vec2 inPosition)
-{
-	position = inPosition;
-}
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
 
-void TextRenderer::setText(std::string inText)
-{
-	text = inText;
+	// Grow the buffer when needed, otherwise orphan it and refill
+	if (size > vboSize)
+	{
+		vboSize = size;
+	}
+	glBufferData(GL_ARRAY_BUFFER, vboSize, NULL, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, &vertices[0]);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
\ No newline at end of file
@@ -8,13 +8,17 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
-#include <map>
+#include "RenderQueue.h"
+#include "ShaderProgram.h"
+
 #include <string>
+#include <vector>
 #include <iostream>
 
 struct Character 
 {
-	GLuint		TextureID;	// Texture ID of each glyph texture
+	glm::vec2	UVMin;		// top left of the glyph in the atlas
+	glm::vec2	UVMax;		// bottom right of the glyph in the atlas
 	glm::ivec2	Size;		// glyph size
 	glm::ivec2	Bearing;	// baseline to left/top of glyph
 	GLuint		Advance;	// id to next glyph
@@ -24,22 +28,33 @@ class TextRenderer
 {
 public:
 	TextRenderer(std::string inText, std::string inFont, int inSize, 
-		glm::vec3 inColor, GLuint inProgram);
+		glm::vec3 inColor, ShaderProgram* inProgram);
 	~TextRenderer();
 
-	void draw();
+	// Always lands in the overlay pass, after everything in the scene
+	void submit(RenderQueue* queue);
 	void setPosition(glm::vec2 inPosition);
 	void setText(std::string inText);
 
 private:
 
+	void rebuild();
+
 	std::string text;
 	GLfloat		scale;
+	GLfloat		lineHeight;	// pixels between baselines at scale 1
 	glm::vec3	color;
 	glm::vec2	position;
+	glm::mat4	projection;
+	bool		projectionSet;	// uploaded on the first draw with a ready program
 	GLuint		VAO;
 	GLuint		VBO;
-	GLuint		program;
-
-	std::map<GLchar, Character> characters;
+	GLuint		atlas;		// every glyph packed into one texture
+	GLsizeiptr	vboSize;	// bytes currently allocated for VBO
+	GLsizei		vertexCount;
+	bool		dirty;		// text or position changed since last rebuild
+	ShaderProgram*	program;
+
+	// Glyphs indexed directly by ASCII code
+	Character	characters[128];
 };
\ No newline at end of file
@@ -3,42 +3,292 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+Texture::Texture(GLuint inID)
+{
+	id = inID;
+}
+
+Texture::~Texture()
+{
+	glDeleteTextures(1, &id);
+}
+
 TextureLoader::TextureLoader()
 {
+	workers			= new ThreadPool(ThreadPool::getDefaultThreadCount());
+	uploadBudget	= 8 * 1024 * 1024;
+	pendingCount	= 0;
+
+	// Without it .dds files are expanded to RGBA8 on the workers
+	compressionSupported = GLEW_EXT_texture_compression_s3tc;
+
+	glGenBuffers(1, &pbo);
 }
 
 TextureLoader::~TextureLoader()
 {
+	// Joins the workers, so nothing writes to decoded after this
+	delete workers;
+
+	glDeleteBuffers(1, &pbo);
 }
 
-GLuint TextureLoader::getTextureID(std::string texFilename)
+TextureHandle TextureLoader::getTexture(std::string texFilename)
 {
+	TextureHandle texture = textures[texFilename].lock();
+
+	if (texture)
+	{
+		return texture;
+	}
+
+	GLuint mtexture;
+	glGenTextures(1, &mtexture);
+	fillPlaceholder(mtexture);
+
+	texture = std::make_shared<Texture>(mtexture);
+	textures[texFilename] = texture;
+
+	pendingCount++;
+
+	std::weak_ptr<Texture> target = texture;
+
+	workers->enqueue([this, target, texFilename]()
+	{
+		DecodedImage image;
+		image.texture	= target;
+		image.filename	= texFilename;
+
+		decode(image);
+
+		std::lock_guard<std::mutex> lock(decodedMutex);
+		decoded.push_back(std::move(image));
+	});
+
+	return texture;
+}
+
+void TextureLoader::update()
+{
+	std::vector<DecodedImage> ready;
+
+	{
+		std::lock_guard<std::mutex> lock(decodedMutex);
+
+		// Take images in decode order until this frame's budget is spent,
+		// the rest stay queued for the next frame
+		size_t uploaded = 0;
+		size_t count = 0;
+
+		while (count < decoded.size() && uploaded < uploadBudget)
+		{
+			uploaded += decoded[count].pixels.size();
+			count++;
+		}
+
+		// Moved rather than copied, only the pixel buffers' pointers change
+		// hands while the workers are locked out
+		ready.assign(std::make_move_iterator(decoded.begin()),
+			std::make_move_iterator(decoded.begin() + count));
+		decoded.erase(decoded.begin(), decoded.begin() + count);
+	}
+
+	for (DecodedImage& image : ready)
+	{
+		upload(image);
+		pendingCount--;
+	}
+}
+
+int TextureLoader::getPendingCount()
+{
+	return pendingCount;
+}
+
+void TextureLoader::decode(DecodedImage& image)
+{
+	image.format		= 0;
+	image.compressed	= false;
+	image.generateMips	= false;
+
+	if (decodeCompressed(image, DdsFile::getCompressedPath(image.filename)))
+	{
+		return;
+	}
+
 	int width;
 	int height;
 	int channels;
+	stbi_uc* pixels = stbi_load(image.filename.c_str(), &width, &height,
+		&channels, STBI_rgb);
 
-	stbi_uc* image = stbi_load(texFilename.c_str(), &width, &height, &channels,
-		STBI_rgb);
+	if (pixels == NULL)
+	{
+		return;
+	}
 
-	GLuint mtexture;
-	glGenTextures(1, &mtexture);
-	glBindTexture(GL_TEXTURE_2D, mtexture);
+	DecodedLevel level;
+	level.width		= width;
+	level.height	= height;
+	level.offset	= 0;
+	level.size		= (size_t)width * height * 3;
+
+	image.format		= GL_RGB;
+	image.generateMips	= true;
+	image.pixels.assign(pixels, pixels + level.size);
+	image.levels.push_back(level);
+
+	stbi_image_free(pixels);
+}
+
+bool TextureLoader::decodeCompressed(DecodedImage& image,
+	const std::string& ddsFilename)
+{
+	DdsImage dds;
+
+	if (!DdsFile::load(ddsFilename, dds))
+	{
+		return false;
+	}
+
+	for (const DdsLevel& ddsLevel : dds.levels)
+	{
+		DecodedLevel level;
+		level.width		= (GLsizei)ddsLevel.width;
+		level.height	= (GLsizei)ddsLevel.height;
+		level.offset	= ddsLevel.offset;
+		level.size		= ddsLevel.size;
+
+		image.levels.push_back(level);
+	}
+
+	if (compressionSupported)
+	{
+		image.format = dds.format == kBlockFormatBC1
+			? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		image.compressed = true;
+		image.pixels.swap(dds.data);
+
+		return true;
+	}
+
+	// Expand every level to RGBA8, still skipping mip generation
+	size_t offset = 0;
+
+	for (DecodedLevel& level : image.levels)
+	{
+		level.offset	= offset;
+		level.size		= (size_t)level.width * level.height * 4;
+		offset			+= level.size;
+	}
+
+	image.pixels.resize(offset);
+
+	for (size_t i = 0; i < image.levels.size(); i++)
+	{
+		BlockCompression::decompress(dds.format, &dds.data[dds.levels[i].offset],
+			dds.levels[i].width, dds.levels[i].height,
+			&image.pixels[image.levels[i].offset]);
+	}
+
+	image.format = GL_RGBA;
+
+	return true;
+}
+
+void TextureLoader::fillPlaceholder(GLuint texture)
+{
+	// Single mid-grey texel until the real image is resident
+	const unsigned char grey[3] = { 128, 128, 128 };
+
+	glBindTexture(GL_TEXTURE_2D, texture);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-		GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB,
-		GL_UNSIGNED_BYTE, image);
-
-	glGenerateMipmap(GL_TEXTURE_2D);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE,
+		grey);
 
 	// unbind
 	glBindTexture(GL_TEXTURE_2D, 0);
-	stbi_image_free(image);
+}
+
+void TextureLoader::upload(DecodedImage& image)
+{
+	// Everyone released the texture before it finished loading
+	TextureHandle texture = image.texture.lock();
+
+	if (!texture)
+	{
+		return;
+	}
+
+	if (image.format == 0)
+	{
+		std::cout << "Can't load texture " << image.filename << '\n';
+		return;
+	}
+
+	GLsizeiptr size = (GLsizeiptr)image.pixels.size();
+
+	// Copy into a freshly orphaned PBO, the texture upload then reads from it
+	// without stalling on the previous upload
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
 
-	return mtexture;
-}
\ No newline at end of file
+	void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+	if (mapped != NULL)
+	{
+		memcpy(mapped, image.pixels.data(), size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+		glBindTexture(GL_TEXTURE_2D, texture->id);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+			GL_LINEAR_MIPMAP_LINEAR);
+
+		// RGB rows are not always 4-byte aligned
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		for (size_t i = 0; i < image.levels.size(); i++)
+		{
+			const DecodedLevel& level = image.levels[i];
+
+			if (image.compressed)
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, image.format,
+					level.width, level.height, 0, (GLsizei)level.size,
+					(void*)level.offset);
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, (GLint)i, image.format, level.width,
+					level.height, 0, image.format, GL_UNSIGNED_BYTE,
+					(void*)level.offset);
+			}
+		}
+
+		if (image.generateMips)
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
+		else
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+				(GLint)image.levels.size() - 1);
+		}
+
+		// unbind
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
@@ -3,11 +3,87 @@
 #include <string>
 #include <GL/glew.h>
 
+#include "DdsFile.h"
+#include "ThreadPool.h"
+
+// std
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// A GL texture shared by everything that loaded the same file. The texture
+// is deleted when the last TextureHandle goes away.
+struct Texture
+{
+	Texture(GLuint inID);
+	~Texture();
+
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+
+	GLuint id;
+};
+
+typedef std::shared_ptr<Texture> TextureHandle;
+
 class TextureLoader
 {
 public:
 	TextureLoader();
 	~TextureLoader();
 
-	GLuint getTextureID(std::string texFilename);
-};
\ No newline at end of file
+	// Returns the texture already loaded from this file if anyone still holds
+	// it. Otherwise returns a new texture straight away that shows a
+	// placeholder until the image has been decoded on a worker and uploaded
+	// by update(). A .dds made by TextureCompressor next to the file is used
+	// instead when there is one, its blocks and mips go up unchanged.
+	TextureHandle getTexture(std::string texFilename);
+
+	// Uploads decoded images through a pixel buffer object, stopping once
+	// uploadBudget bytes have gone up this frame. Call once per frame on the
+	// render thread.
+	void update();
+
+	int getPendingCount();
+
+private:
+
+	struct DecodedLevel
+	{
+		GLsizei	width;
+		GLsizei	height;
+		size_t	offset;		// into DecodedImage::pixels
+		size_t	size;
+	};
+
+	struct DecodedImage
+	{
+		std::weak_ptr<Texture>		texture;		// expired if released meanwhile
+		std::string					filename;
+		GLenum						format;			// 0 on failure
+		bool						compressed;
+		bool						generateMips;	// only the top level was decoded
+		std::vector<unsigned char>	pixels;			// every level, back to back
+		std::vector<DecodedLevel>	levels;
+	};
+
+	void decode(DecodedImage& image);
+	bool decodeCompressed(DecodedImage& image, const std::string& ddsFilename);
+
+	void fillPlaceholder(GLuint texture);
+	void upload(DecodedImage& image);
+
+	ThreadPool*					workers;
+	GLuint						pbo;
+	size_t						uploadBudget;
+	bool						compressionSupported;	// S3TC blocks can be sampled
+	int							pendingCount;	// queued but not resident
+
+	std::mutex					decodedMutex;
+	std::vector<DecodedImage>	decoded;		// written by workers
+
+	// Weak references only, the cache never keeps a texture alive
+	std::unordered_map<std::string, std::weak_ptr<Texture>> textures;
+};
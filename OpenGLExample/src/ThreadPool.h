@@ -0,0 +1,34 @@
+#pragma once
+
+// std
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads pulling tasks from a shared queue
+class ThreadPool
+{
+public:
+	ThreadPool(int threadCount);
+	~ThreadPool();
+
+	void enqueue(std::function<void()> task);
+
+	int getThreadCount();
+
+	// Worker count that leaves one core for the render thread
+	static int getDefaultThreadCount();
+
+private:
+
+	void workerLoop();
+
+	std::vector<std::thread>			workers;
+	std::deque<std::function<void()>>	tasks;
+	std::mutex							mutex;
+	std::condition_variable				condition;
+	bool								stopping;
+};
@@ -0,0 +1,58 @@
+#include "TransformBuffer.h"
+
+#include "ShaderProgram.h"
+
+// std
+#include <algorithm>
+#include <cstring>
+
+// Worst case padding for the two aligned allocations
+static const GLsizeiptr kAlignmentSlack = 2 * 256;
+
+TransformBuffer::TransformBuffer(StreamBuffer* inStream)
+{
+	stream = inStream;
+
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+}
+
+void TransformBuffer::update(EntityStore* entities)
+{
+	// Empty ranges can't be bound
+	size_t count = std::max(entities->getCount(), (size_t)1);
+
+	GLsizeiptr modelSize	= sizeof(glm::mat4) * count;
+	GLsizeiptr normalSize	= sizeof(NormalMatrix) * count;
+
+	GLintptr modelOffset;
+	GLintptr normalOffset;
+
+	void* models = stream->allocate(modelSize, alignment, &modelOffset);
+	void* normals = stream->allocate(normalSize, alignment, &normalOffset);
+
+	// The stream is sized with getFrameSize(), this only guards against misuse
+	if (models == NULL || normals == NULL)
+	{
+		return;
+	}
+
+	// The arrays are already packed the way the shader reads them
+	if (entities->getCount() > 0)
+	{
+		memcpy(models, entities->transforms.data(),
+			sizeof(glm::mat4) * entities->getCount());
+		memcpy(normals, entities->normalMatrices.data(),
+			sizeof(NormalMatrix) * entities->getCount());
+	}
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kModelDataBinding,
+		stream->getBuffer(), modelOffset, modelSize);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, kNormalDataBinding,
+		stream->getBuffer(), normalOffset, normalSize);
+}
+
+GLsizeiptr TransformBuffer::getFrameSize(size_t capacity)
+{
+	return (GLsizeiptr)((sizeof(glm::mat4) + sizeof(NormalMatrix)) *
+		std::max(capacity, (size_t)1)) + kAlignmentSlack;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "EntityStore.h"
+#include "StreamBuffer.h"
+
+// Model and normal matrices of every entity, copied each frame from the
+// entity store's arrays into the frame's stream buffer and bound as two
+// shader storage ranges. Instances only carry their entity's index, the
+// vertex shader fetches the matrices with it.
+class TransformBuffer
+{
+public:
+	TransformBuffer(StreamBuffer* inStream);
+
+	// Call after InstancedRenderer::submit() has built the visible entities'
+	// transforms, between the stream's beginFrame() and flush(). Culled
+	// entities keep stale matrices, nothing reads them.
+	void update(EntityStore* entities);
+
+	// Most update() writes into the stream in one frame, for sizing it
+	static GLsizeiptr getFrameSize(size_t capacity);
+
+private:
+
+	StreamBuffer*	stream;
+	GLint			alignment;	// GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+};
@@ -0,0 +1,413 @@
+#include "BlockCompression.h"
+
+// std
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+static uint16_t packRgb565(const float* color)
+{
+	int r = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+	int g = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+	int b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+
+	return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpackRgb565(uint16_t packed, int* color)
+{
+	int r = (packed >> 11) & 31;
+	int g = (packed >> 5) & 63;
+	int b = packed & 31;
+
+	// replicate the top bits so 31 and 63 expand to exactly 255
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+size_t BlockCompression::getBlockSize(BlockFormat format)
+{
+	return format == kBlockFormatBC1 ? 8 : 16;
+}
+
+size_t BlockCompression::getLevelSize(BlockFormat format, uint32_t width,
+	uint32_t height)
+{
+	size_t blocksWide = (width + 3) / 4;
+	size_t blocksHigh = (height + 3) / 4;
+
+	return blocksWide * blocksHigh * getBlockSize(format);
+}
+
+void BlockCompression::compress(BlockFormat format, const uint8_t* rgba,
+	uint32_t width, uint32_t height, uint8_t* blocks)
+{
+	uint8_t texels[16 * 4];
+
+	for (uint32_t blockY = 0; blockY < height; blockY += 4)
+	{
+		for (uint32_t blockX = 0; blockX < width; blockX += 4)
+		{
+			// Gather the block, clamping at the right and bottom edges
+			for (uint32_t y = 0; y < 4; y++)
+			{
+				uint32_t sourceY = blockY + y < height ? blockY + y : height - 1;
+
+				for (uint32_t x = 0; x < 4; x++)
+				{
+					uint32_t sourceX = blockX + x < width ? blockX + x : width - 1;
+
+					memcpy(&texels[(y * 4 + x) * 4],
+						&rgba[((size_t)sourceY * width + sourceX) * 4], 4);
+				}
+			}
+
+			if (format == kBlockFormatBC3)
+			{
+				compressAlphaBlock(texels, blocks);
+				blocks += 8;
+			}
+
+			compressColorBlock(texels, blocks);
+			blocks += 8;
+		}
+	}
+}
+
+void BlockCompression::decompress(BlockFormat format, const uint8_t* blocks,
+	uint32_t width, uint32_t height, uint8_t* rgba)
+{
+	uint8_t texels[16 * 4];
+
+	for (uint32_t blockY = 0; blockY < height; blockY += 4)
+	{
+		for (uint32_t blockX = 0; blockX < width; blockX += 4)
+		{
+			if (format == kBlockFormatBC3)
+			{
+				// BC3 colour blocks are always in four colour mode
+				decompressColorBlock(blocks + 8, false, texels);
+				decompressAlphaBlock(blocks, texels);
+				blocks += 16;
+			}
+			else
+			{
+				decompressColorBlock(blocks, true, texels);
+				blocks += 8;
+			}
+
+			// Write back only the texels inside the image
+			for (uint32_t y = 0; y < 4 && blockY + y < height; y++)
+			{
+				for (uint32_t x = 0; x < 4 && blockX + x < width; x++)
+				{
+					memcpy(&rgba[((size_t)(blockY + y) * width + blockX + x) * 4],
+						&texels[(y * 4 + x) * 4], 4);
+				}
+			}
+		}
+	}
+}
+
+void BlockCompression::compressColorBlock(const uint8_t* texels, uint8_t* block)
+{
+	// Mean and covariance of the block's colours
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			mean[c] += texels[i * 4 + c] / 16.0f;
+		}
+	}
+
+	float covariance[3][3] = {};
+
+	for (int i = 0; i < 16; i++)
+	{
+		float d[3];
+
+		for (int c = 0; c < 3; c++)
+		{
+			d[c] = texels[i * 4 + c] - mean[c];
+		}
+
+		for (int row = 0; row < 3; row++)
+		{
+			for (int column = 0; column < 3; column++)
+			{
+				covariance[row][column] += d[row] * d[column];
+			}
+		}
+	}
+
+	// The principal axis by power iteration, a flat block keeps the
+	// grey diagonal
+	float axis[3] = { 1.0f, 1.0f, 1.0f };
+
+	for (int iteration = 0; iteration < 8; iteration++)
+	{
+		float next[3];
+		float largest = 0.0f;
+
+		for (int row = 0; row < 3; row++)
+		{
+			next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1]
+				+ covariance[row][2] * axis[2];
+			largest = fmaxf(largest, fabsf(next[row]));
+		}
+
+		if (largest < FLT_EPSILON)
+		{
+			break;
+		}
+
+		for (int c = 0; c < 3; c++)
+		{
+			axis[c] = next[c] / largest;
+		}
+	}
+
+	// The extremes along the axis become the endpoints
+	float minProjection = FLT_MAX;
+	float maxProjection = -FLT_MAX;
+
+	for (int i = 0; i < 16; i++)
+	{
+		float projection = (texels[i * 4] - mean[0]) * axis[0]
+			+ (texels[i * 4 + 1] - mean[1]) * axis[1]
+			+ (texels[i * 4 + 2] - mean[2]) * axis[2];
+
+		minProjection = fminf(minProjection, projection);
+		maxProjection = fmaxf(maxProjection, projection);
+	}
+
+	float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+	// Inset the endpoints by 1/16 of the range, the outliers then land close
+	// to an endpoint and the rest of the block gets more precision
+	float inset = (maxProjection - minProjection) / 16.0f;
+	minProjection += inset;
+	maxProjection -= inset;
+
+	float maxColor[3];
+	float minColor[3];
+
+	for (int c = 0; c < 3; c++)
+	{
+		maxColor[c] = fminf(fmaxf(mean[c] + axis[c] * maxProjection / axisLengthSquared, 0.0f), 255.0f);
+		minColor[c] = fminf(fmaxf(mean[c] + axis[c] * minProjection / axisLengthSquared, 0.0f), 255.0f);
+	}
+
+	uint16_t color0 = packRgb565(maxColor);
+	uint16_t color1 = packRgb565(minColor);
+
+	// color0 > color1 selects four colour mode
+	if (color0 < color1)
+	{
+		uint16_t swap = color0;
+		color0 = color1;
+		color1 = swap;
+	}
+
+	int palette[4][3];
+	unpackRgb565(color0, palette[0]);
+	unpackRgb565(color1, palette[1]);
+
+	for (int c = 0; c < 3; c++)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = 0;
+
+	// With equal endpoints every texel uses index 0
+	if (color0 != color1)
+	{
+		for (int i = 0; i < 16; i++)
+		{
+			int bestIndex = 0;
+			int bestDistance = INT32_MAX;
+
+			for (int p = 0; p < 4; p++)
+			{
+				int dr = texels[i * 4] - palette[p][0];
+				int dg = texels[i * 4 + 1] - palette[p][1];
+				int db = texels[i * 4 + 2] - palette[p][2];
+				int distance = dr * dr + dg * dg + db * db;
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			indices |= (uint32_t)bestIndex << (i * 2);
+		}
+	}
+
+	block[0] = (uint8_t)(color0 & 0xFF);
+	block[1] = (uint8_t)(color0 >> 8);
+	block[2] = (uint8_t)(color1 & 0xFF);
+	block[3] = (uint8_t)(color1 >> 8);
+	block[4] = (uint8_t)(indices & 0xFF);
+	block[5] = (uint8_t)((indices >> 8) & 0xFF);
+	block[6] = (uint8_t)((indices >> 16) & 0xFF);
+	block[7] = (uint8_t)(indices >> 24);
+}
+
+void BlockCompression::compressAlphaBlock(const uint8_t* texels, uint8_t* block)
+{
+	int alpha0 = 0;
+	int alpha1 = 255;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int alpha = texels[i * 4 + 3];
+
+		if (alpha > alpha0)
+		{
+			alpha0 = alpha;
+		}
+
+		if (alpha < alpha1)
+		{
+			alpha1 = alpha;
+		}
+	}
+
+	uint64_t indices = 0;
+
+	// alpha0 > alpha1 selects eight alpha mode, equal endpoints use index 0
+	if (alpha0 != alpha1)
+	{
+		int palette[8];
+		palette[0] = alpha0;
+		palette[1] = alpha1;
+
+		for (int p = 0; p < 6; p++)
+		{
+			palette[p + 2] = ((6 - p) * alpha0 + (p + 1) * alpha1) / 7;
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			int bestIndex = 0;
+			int bestDistance = 256;
+
+			for (int p = 0; p < 8; p++)
+			{
+				int distance = abs(texels[i * 4 + 3] - palette[p]);
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+
+			indices |= (uint64_t)bestIndex << (i * 3);
+		}
+	}
+
+	block[0] = (uint8_t)alpha0;
+	block[1] = (uint8_t)alpha1;
+
+	// 48 bits of 3-bit indices
+	for (int i = 0; i < 6; i++)
+	{
+		block[2 + i] = (uint8_t)((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+void BlockCompression::decompressColorBlock(const uint8_t* block,
+	bool allowTransparent, uint8_t* texels)
+{
+	uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+	uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+	uint32_t indices = (uint32_t)block[4] | ((uint32_t)block[5] << 8)
+		| ((uint32_t)block[6] << 16) | ((uint32_t)block[7] << 24);
+
+	int palette[4][4];
+	unpackRgb565(color0, palette[0]);
+	unpackRgb565(color1, palette[1]);
+
+	if (color0 > color1 || !allowTransparent)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+
+		palette[3][3] = 255;
+	}
+	else
+	{
+		// three colour mode, index 3 is transparent black
+		for (int c = 0; c < 3; c++)
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+
+		palette[3][3] = 0;
+	}
+
+	palette[0][3] = 255;
+	palette[1][3] = 255;
+	palette[2][3] = 255;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int index = (indices >> (i * 2)) & 3;
+
+		for (int c = 0; c < 4; c++)
+		{
+			texels[i * 4 + c] = (uint8_t)palette[index][c];
+		}
+	}
+}
+
+void BlockCompression::decompressAlphaBlock(const uint8_t* block, uint8_t* texels)
+{
+	int palette[8];
+	palette[0] = block[0];
+	palette[1] = block[1];
+
+	if (palette[0] > palette[1])
+	{
+		for (int p = 0; p < 6; p++)
+		{
+			palette[p + 2] = ((6 - p) * palette[0] + (p + 1) * palette[1]) / 7;
+		}
+	}
+	else
+	{
+		// six alpha mode with explicit 0 and 255
+		for (int p = 0; p < 4; p++)
+		{
+			palette[p + 2] = ((4 - p) * palette[0] + (p + 1) * palette[1]) / 5;
+		}
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0;
+
+	for (int i = 0; i < 6; i++)
+	{
+		indices |= (uint64_t)block[2 + i] << (i * 8);
+	}
+
+	for (int i = 0; i < 16; i++)
+	{
+		texels[i * 4 + 3] = (uint8_t)palette[(indices >> (i * 3)) & 7];
+	}
+}
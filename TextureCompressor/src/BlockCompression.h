@@ -0,0 +1,35 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+
+// GPU block formats, each encodes a 4x4 texel block in a fixed number of bytes
+enum BlockFormat {
+	kBlockFormatBC1 = 0,	// RGB, 8 bytes per block
+	kBlockFormatBC3			// RGBA, 16 bytes per block
+};
+
+// Encodes RGBA8 images into BC1/BC3 blocks and decodes them again for drivers
+// that can't sample the compressed formats. Images whose sides aren't a
+// multiple of 4 are padded by repeating the last row and column.
+class BlockCompression
+{
+public:
+	static size_t getBlockSize(BlockFormat format);
+	static size_t getLevelSize(BlockFormat format, uint32_t width, uint32_t height);
+
+	static void compress(BlockFormat format, const uint8_t* rgba, uint32_t width,
+		uint32_t height, uint8_t* blocks);
+	static void decompress(BlockFormat format, const uint8_t* blocks, uint32_t width,
+		uint32_t height, uint8_t* rgba);
+
+private:
+
+	static void compressColorBlock(const uint8_t* texels, uint8_t* block);
+	static void compressAlphaBlock(const uint8_t* texels, uint8_t* block);
+
+	static void decompressColorBlock(const uint8_t* block, bool allowTransparent,
+		uint8_t* texels);
+	static void decompressAlphaBlock(const uint8_t* block, uint8_t* texels);
+};
@@ -0,0 +1,216 @@
+#include "DdsFile.h"
+
+// std
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+static const uint32_t kDdsMagic			= 0x20534444;	// "DDS "
+static const uint32_t kFourCCDXT1		= 0x31545844;	// "DXT1"
+static const uint32_t kFourCCDXT5		= 0x35545844;	// "DXT5"
+
+static const uint32_t kDdsdCaps			= 0x1;
+static const uint32_t kDdsdHeight		= 0x2;
+static const uint32_t kDdsdWidth		= 0x4;
+static const uint32_t kDdsdPixelFormat	= 0x1000;
+static const uint32_t kDdsdMipMapCount	= 0x20000;
+static const uint32_t kDdsdLinearSize	= 0x80000;
+static const uint32_t kDdpfFourCC		= 0x4;
+static const uint32_t kDdsCapsComplex	= 0x8;
+static const uint32_t kDdsCapsTexture	= 0x1000;
+static const uint32_t kDdsCapsMipMap	= 0x400000;
+
+struct DdsPixelFormat
+{
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t rBitMask;
+	uint32_t gBitMask;
+	uint32_t bBitMask;
+	uint32_t aBitMask;
+};
+
+struct DdsHeader
+{
+	uint32_t		size;
+	uint32_t		flags;
+	uint32_t		height;
+	uint32_t		width;
+	uint32_t		pitchOrLinearSize;
+	uint32_t		depth;
+	uint32_t		mipMapCount;
+	uint32_t		reserved1[11];
+	DdsPixelFormat	pixelFormat;
+	uint32_t		caps;
+	uint32_t		caps2;
+	uint32_t		caps3;
+	uint32_t		caps4;
+	uint32_t		reserved2;
+};
+
+static_assert(sizeof(DdsHeader) == 124, "DdsHeader must match the file layout");
+
+bool DdsFile::load(const std::string& filename, DdsImage& image)
+{
+	std::ifstream file(filename, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	uint32_t magic = 0;
+	DdsHeader header;
+
+	file.read((char*)&magic, sizeof(magic));
+	file.read((char*)&header, sizeof(header));
+
+	if (!file || magic != kDdsMagic || header.size != sizeof(DdsHeader))
+	{
+		std::cout << "Not a DDS file: " << filename << '\n';
+		return false;
+	}
+
+	if (!(header.pixelFormat.flags & kDdpfFourCC)
+		|| (header.pixelFormat.fourCC != kFourCCDXT1
+			&& header.pixelFormat.fourCC != kFourCCDXT5))
+	{
+		std::cout << "Unsupported DDS format, expected DXT1 or DXT5: " << filename << '\n';
+		return false;
+	}
+
+	image.format = header.pixelFormat.fourCC == kFourCCDXT1 ? kBlockFormatBC1
+		: kBlockFormatBC3;
+
+	if (header.width == 0 || header.height == 0)
+	{
+		std::cout << "DDS file has no pixels: " << filename << '\n';
+		return false;
+	}
+
+	uint32_t levelCount = 1;
+
+	if ((header.flags & kDdsdMipMapCount) && header.mipMapCount > 1)
+	{
+		levelCount = header.mipMapCount;
+	}
+
+	// A full chain ends at 1x1, log2(max(width, height)) + 1 levels
+	uint32_t maxLevelCount = 1;
+
+	for (uint32_t size = std::max(header.width, header.height); size > 1; size /= 2)
+	{
+		maxLevelCount++;
+	}
+
+	if (levelCount > maxLevelCount)
+	{
+		std::cout << "DDS file has too many mip levels: " << filename << '\n';
+		return false;
+	}
+
+	// Everything after the header is level data
+	std::streamoff dataStart = file.tellg();
+	file.seekg(0, std::ios::end);
+	std::streamoff fileSize = file.tellg();
+	file.seekg(dataStart, std::ios::beg);
+
+	image.levels.clear();
+
+	uint32_t width = header.width;
+	uint32_t height = header.height;
+	size_t offset = 0;
+
+	for (uint32_t i = 0; i < levelCount; i++)
+	{
+		DdsLevel level;
+		level.width = width;
+		level.height = height;
+		level.offset = offset;
+		level.size = BlockCompression::getLevelSize(image.format, width, height);
+
+		image.levels.push_back(level);
+		offset += level.size;
+
+		if (width > 1)
+		{
+			width /= 2;
+		}
+
+		if (height > 1)
+		{
+			height /= 2;
+		}
+	}
+
+	// Checked before allocating, so a bad header can't ask for more memory
+	// than the file holds or leave levels pointing past the end of data
+	if (dataStart < 0 || fileSize < dataStart ||
+		offset > (size_t)(fileSize - dataStart))
+	{
+		std::cout << "DDS file is truncated: " << filename << '\n';
+		return false;
+	}
+
+	image.data.resize(offset);
+	file.read((char*)image.data.data(), offset);
+
+	if (!file)
+	{
+		std::cout << "DDS file is truncated: " << filename << '\n';
+		return false;
+	}
+
+	return true;
+}
+
+bool DdsFile::save(const std::string& filename, const DdsImage& image)
+{
+	std::ofstream file(filename, std::ios::binary);
+
+	if (!file.is_open() || image.levels.empty())
+	{
+		std::cout << "Can't write " << filename << '\n';
+		return false;
+	}
+
+	DdsHeader header = {};
+	header.size					= sizeof(DdsHeader);
+	header.flags				= kDdsdCaps | kDdsdHeight | kDdsdWidth | kDdsdPixelFormat
+		| kDdsdMipMapCount | kDdsdLinearSize;
+	header.width				= image.levels[0].width;
+	header.height				= image.levels[0].height;
+	header.pitchOrLinearSize	= (uint32_t)image.levels[0].size;
+	header.mipMapCount			= (uint32_t)image.levels.size();
+	header.pixelFormat.size		= sizeof(DdsPixelFormat);
+	header.pixelFormat.flags	= kDdpfFourCC;
+	header.pixelFormat.fourCC	= image.format == kBlockFormatBC1 ? kFourCCDXT1 : kFourCCDXT5;
+	header.caps					= kDdsCapsTexture;
+
+	if (image.levels.size() > 1)
+	{
+		header.caps |= kDdsCapsComplex | kDdsCapsMipMap;
+	}
+
+	file.write((const char*)&kDdsMagic, sizeof(kDdsMagic));
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)image.data.data(), image.data.size());
+
+	return (bool)file;
+}
+
+std::string DdsFile::getCompressedPath(const std::string& filename)
+{
+	size_t dot = filename.find_last_of('.');
+	size_t slash = filename.find_last_of("/\\");
+
+	// only strip a dot that belongs to the file name, not a directory
+	if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+	{
+		return filename + ".dds";
+	}
+
+	return filename.substr(0, dot) + ".dds";
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "BlockCompression.h"
+
+// std
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct DdsLevel
+{
+	uint32_t	width;
+	uint32_t	height;
+	size_t		offset;		// into DdsImage::data
+	size_t		size;
+};
+
+// A block-compressed texture and its full mip chain, largest level first.
+// The levels are packed back to back in data, the same layout they have in
+// the file, so the whole chain can be copied into one upload buffer.
+struct DdsImage
+{
+	BlockFormat				format;
+	std::vector<DdsLevel>	levels;
+	std::vector<uint8_t>	data;
+};
+
+// Reads and writes the DXT1/DXT5 subset of the DirectDraw Surface format
+class DdsFile
+{
+public:
+	static bool load(const std::string& filename, DdsImage& image);
+	static bool save(const std::string& filename, const DdsImage& image);
+
+	// The file the converter writes for a source image, the same path with
+	// a .dds extension
+	static std::string getCompressedPath(const std::string& filename);
+};
@@ -0,0 +1,178 @@
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "BlockCompression.h"
+#include "DdsFile.h"
+
+/**
+* Converts source images into .dds files next to them, block compressed with
+* the full mip chain, for the examples' texture loaders to upload directly.
+*
+* Usage: TextureCompressor [--bc1 | --bc3] <image> [<image> ...]
+*
+* Without a format option, images with any transparent texel use BC3 and
+* the rest BC1.
+*/
+
+// Halves an RGBA8 level with a 2x2 box filter, odd edges reuse the last texel
+void downsample(const std::vector<uint8_t>& source, uint32_t width, uint32_t height,
+	std::vector<uint8_t>& destination, uint32_t& outWidth, uint32_t& outHeight)
+{
+	outWidth = width > 1 ? width / 2 : 1;
+	outHeight = height > 1 ? height / 2 : 1;
+
+	destination.resize((size_t)outWidth * outHeight * 4);
+
+	for (uint32_t y = 0; y < outHeight; y++)
+	{
+		uint32_t y0 = y * 2 < height ? y * 2 : height - 1;
+		uint32_t y1 = y * 2 + 1 < height ? y * 2 + 1 : height - 1;
+
+		for (uint32_t x = 0; x < outWidth; x++)
+		{
+			uint32_t x0 = x * 2 < width ? x * 2 : width - 1;
+			uint32_t x1 = x * 2 + 1 < width ? x * 2 + 1 : width - 1;
+
+			for (int c = 0; c < 4; c++)
+			{
+				int sum = source[((size_t)y0 * width + x0) * 4 + c]
+					+ source[((size_t)y0 * width + x1) * 4 + c]
+					+ source[((size_t)y1 * width + x0) * 4 + c]
+					+ source[((size_t)y1 * width + x1) * 4 + c];
+
+				destination[((size_t)y * outWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+			}
+		}
+	}
+}
+
+bool hasTransparency(const std::vector<uint8_t>& rgba)
+{
+	for (size_t i = 3; i < rgba.size(); i += 4)
+	{
+		if (rgba[i] != 255)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool convert(const std::string& filename, bool forceFormat, BlockFormat forcedFormat)
+{
+	int width;
+	int height;
+	int channels;
+
+	stbi_uc* pixels = stbi_load(filename.c_str(), &width, &height, &channels,
+		STBI_rgb_alpha);
+
+	if (pixels == NULL)
+	{
+		std::cout << "Can't load " << filename << '\n';
+		return false;
+	}
+
+	std::vector<uint8_t> level(pixels, pixels + (size_t)width * height * 4);
+	stbi_image_free(pixels);
+
+	DdsImage image;
+	image.format = kBlockFormatBC1;
+
+	if (forceFormat)
+	{
+		image.format = forcedFormat;
+	}
+	else if (hasTransparency(level))
+	{
+		image.format = kBlockFormatBC3;
+	}
+
+	uint32_t levelWidth = (uint32_t)width;
+	uint32_t levelHeight = (uint32_t)height;
+
+	// Compress each level down to 1x1
+	while (true)
+	{
+		DdsLevel dds;
+		dds.width = levelWidth;
+		dds.height = levelHeight;
+		dds.offset = image.data.size();
+		dds.size = BlockCompression::getLevelSize(image.format, levelWidth, levelHeight);
+
+		image.data.resize(dds.offset + dds.size);
+		BlockCompression::compress(image.format, level.data(), levelWidth, levelHeight,
+			&image.data[dds.offset]);
+
+		image.levels.push_back(dds);
+
+		if (levelWidth == 1 && levelHeight == 1)
+		{
+			break;
+		}
+
+		std::vector<uint8_t> next;
+		downsample(level, levelWidth, levelHeight, next, levelWidth, levelHeight);
+		level.swap(next);
+	}
+
+	std::string output = DdsFile::getCompressedPath(filename);
+
+	if (!DdsFile::save(output, image))
+	{
+		return false;
+	}
+
+	size_t sourceSize = (size_t)width * height * 4;
+
+	std::cout << filename << " -> " << output << " ("
+		<< (image.format == kBlockFormatBC1 ? "BC1" : "BC3") << ", "
+		<< image.levels.size() << " levels, " << image.data.size() / 1024 << " KB, "
+		<< sourceSize / 1024 << " KB as RGBA8 without mips)\n";
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	bool forceFormat = false;
+	BlockFormat forcedFormat = kBlockFormatBC1;
+	int failed = 0;
+	int converted = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--bc1") == 0)
+		{
+			forceFormat = true;
+			forcedFormat = kBlockFormatBC1;
+		}
+		else if (strcmp(argv[i], "--bc3") == 0)
+		{
+			forceFormat = true;
+			forcedFormat = kBlockFormatBC3;
+		}
+		else if (convert(argv[i], forceFormat, forcedFormat))
+		{
+			converted++;
+		}
+		else
+		{
+			failed++;
+		}
+	}
+
+	if (converted + failed == 0)
+	{
+		std::cout << "Usage: TextureCompressor [--bc1 | --bc3] <image> [<image> ...]\n";
+		return 1;
+	}
+
+	return failed == 0 ? 0 : 1;
+}
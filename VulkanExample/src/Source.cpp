@@ -28,6 +28,9 @@
 #include <chrono>
 #include <unordered_map>
 
+#include "BlockCompression.h"
+#include "DdsFile.h"
+
 const uint32_t WIDTH  = 1920;		
 const uint16_t HEIGHT = 1080;	
 
@@ -107,7 +110,6 @@ struct SwapChainSupportDetails
 struct Vertex 
 {
 	glm::vec3 pos;
-	glm::vec3 color;
 	glm::vec2 texCoord;
 
 	static VkVertexInputBindingDescription getBindingDescription() {
@@ -119,9 +121,9 @@ struct Vertex
 		return bindingDescription;
 	}
 
-	static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions() 
+	static std::array<VkVertexInputAttributeDescription, 2> getAttributeDescriptions() 
 	{
-		std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
+		std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
 
 		// position
 		attributeDescriptions[0].binding = 0;
@@ -129,31 +131,24 @@ struct Vertex
 		attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;	
 		attributeDescriptions[0].offset = offsetof(Vertex, pos);
 
-		// color
-		attributeDescriptions[1].binding = 0;
-		attributeDescriptions[1].location = 1;	
-		attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;	
-		attributeDescriptions[1].offset = offsetof(Vertex, color);
-
 		// texCoords
-		attributeDescriptions[2].binding = 0;
-		attributeDescriptions[2].location = 2;
-		attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;	
-		attributeDescriptions[2].offset = offsetof(Vertex, texCoord);
+		attributeDescriptions[1].binding = 0;
+		attributeDescriptions[1].location = 1;
+		attributeDescriptions[1].format = VK_FORMAT_R32G32_SFLOAT;	
+		attributeDescriptions[1].offset = offsetof(Vertex, texCoord);
 
 		return attributeDescriptions;
 	}
 
 	bool operator==(const Vertex& other) const { return pos == other.pos 
-		&& color == other.color && texCoord == other.texCoord;}
+		&& texCoord == other.texCoord;}
 };
 
 namespace std {
 	template<> struct hash<Vertex> 
 	{
 		size_t operator()(Vertex const& vertex) const {
-			return ((hash<glm::vec3>()(vertex.pos) ^
-				(hash<glm::vec3>()(vertex.color) << 1)) >> 1) ^
+			return (hash<glm::vec3>()(vertex.pos) >> 1) ^
 				(hash<glm::vec2>()(vertex.texCoord) << 1);
 		}
 	};
@@ -211,9 +206,12 @@ private:
 	VkDeviceMemory					vertexBufferMemory;
 	VkBuffer						indexBuffer;
 	VkDeviceMemory					indexBufferMemory;
+	VkIndexType						indexType = VK_INDEX_TYPE_UINT32;
 	std::vector<VkBuffer>			uniformBuffers;
 	std::vector<VkDeviceMemory>		uniformBuffersMemory;
 	uint32_t						mipLevels;
+	VkFormat						textureFormat;
+	bool							textureCompressionBC = false;
 	VkImage							textureImage;
 	VkDeviceMemory					textureImageMemory;
 	VkImageView						textureImageView;
@@ -528,9 +526,16 @@ private:
 		}
 
 
+		VkPhysicalDeviceFeatures supportedFeatures;
+		vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+		// optional, compressed textures are expanded on the CPU without it
+		textureCompressionBC = supportedFeatures.textureCompressionBC == VK_TRUE;
+
 		VkPhysicalDeviceFeatures deviceFeatures{};											
 		deviceFeatures.samplerAnisotropy = VK_TRUE;
 		deviceFeatures.sampleRateShading = VK_TRUE;
+		deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;
 
 		VkDeviceCreateInfo createInfo{};													
 		createInfo.sType					= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;							
@@ -1142,7 +1147,7 @@ private:
 
 			vkCmdBindVertexBuffers(commandBuffers[i], 0, 1, vertexBuffers, offsets);
 
-			vkCmdBindIndexBuffer(commandBuffers[i], indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+			vkCmdBindIndexBuffer(commandBuffers[i], indexBuffer, 0, indexType);
 
 			vkCmdBindDescriptorSets(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS,
 				pipelineLayout, 0, 1, &descriptorSets[i], 0, nullptr);
@@ -1312,6 +1317,15 @@ private:
 
 	void createTextureImage()
 	{
+		// Prefer the block-compressed copy written by TextureCompressor
+		DdsImage dds;
+
+		if (DdsFile::load(DdsFile::getCompressedPath(TEXTURE_PATH), dds))
+		{
+			createCompressedTextureImage(dds);
+			return;
+		}
+
 		int texWidth;
 		int texHeight;
 		int texChannels;
@@ -1341,6 +1355,8 @@ private:
 
 		stbi_image_free(pixels);
 
+		textureFormat = VK_FORMAT_R8G8B8A8_SRGB;
+
 		createImage(texWidth, texHeight, mipLevels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_TILING_OPTIMAL,
 			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
@@ -1360,6 +1376,108 @@ private:
 
 	}
 
+	/**
+	* Purpose:	Upload a .dds with its precomputed mip chain, no mipmaps are
+	*			generated at runtime
+	*/
+	void createCompressedTextureImage(const DdsImage& dds)
+	{
+		mipLevels = static_cast<uint32_t>(dds.levels.size());
+
+		std::vector<VkDeviceSize> levelOffsets(mipLevels);
+		std::vector<uint8_t> expanded;
+		const uint8_t* source = dds.data.data();
+		VkDeviceSize imageSize = dds.data.size();
+
+		if (textureCompressionBC)
+		{
+			textureFormat = dds.format == kBlockFormatBC1 
+				? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC3_SRGB_BLOCK;
+
+			for (uint32_t i = 0; i < mipLevels; i++)
+			{
+				levelOffsets[i] = dds.levels[i].offset;
+			}
+		}
+		else
+		{
+			// The device can't sample BC formats, expand every level to RGBA8
+			textureFormat = VK_FORMAT_R8G8B8A8_SRGB;
+
+			VkDeviceSize offset = 0;
+
+			for (uint32_t i = 0; i < mipLevels; i++)
+			{
+				levelOffsets[i] = offset;
+				offset += static_cast<VkDeviceSize>(dds.levels[i].width) * dds.levels[i].height * 4;
+			}
+
+			expanded.resize(static_cast<size_t>(offset));
+
+			for (uint32_t i = 0; i < mipLevels; i++)
+			{
+				BlockCompression::decompress(dds.format, &dds.data[dds.levels[i].offset],
+					dds.levels[i].width, dds.levels[i].height, &expanded[levelOffsets[i]]);
+			}
+
+			source = expanded.data();
+			imageSize = offset;
+		}
+
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+
+		createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+			| VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+
+		void* data;
+		vkMapMemory(device, stagingBufferMemory, 0, imageSize, 0, &data);
+		memcpy(data, source, static_cast<size_t>(imageSize));
+		vkUnmapMemory(device, stagingBufferMemory);
+
+		createImage(dds.levels[0].width, dds.levels[0].height, mipLevels, VK_SAMPLE_COUNT_1_BIT, 
+			textureFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory);
+
+		transitionImageLayout(textureImage, textureFormat, VK_IMAGE_LAYOUT_UNDEFINED,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipLevels);
+
+		// one copy per level, all from the same staging buffer
+		std::vector<VkBufferImageCopy> regions(mipLevels);
+
+		for (uint32_t i = 0; i < mipLevels; i++)
+		{
+			regions[i].bufferOffset						= levelOffsets[i];
+			regions[i].bufferRowLength					= 0;
+			regions[i].bufferImageHeight				= 0;
+			regions[i].imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+			regions[i].imageSubresource.mipLevel		= i;
+			regions[i].imageSubresource.baseArrayLayer	= 0;
+			regions[i].imageSubresource.layerCount		= 1;
+			regions[i].imageOffset						= { 0, 0, 0 };
+			regions[i].imageExtent						= { dds.levels[i].width, dds.levels[i].height, 1 };
+		}
+
+		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+
+		vkCmdCopyBufferToImage(
+			commandBuffer,
+			stagingBuffer,
+			textureImage,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			mipLevels,
+			regions.data()
+		);
+
+		endSingleTimeCommands(commandBuffer);
+
+		transitionImageLayout(textureImage, textureFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipLevels);
+
+		vkDestroyBuffer(device, stagingBuffer, nullptr);
+		vkFreeMemory(device, stagingBufferMemory, nullptr);
+	}
+
 	void generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, 
 		int32_t texHeight, uint32_t mipLevels)
 	{
@@ -1523,7 +1641,7 @@ private:
 
 	void createTextureImageView()
 	{
-		textureImageView = createImageView(textureImage, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels);
+		textureImageView = createImageView(textureImage, textureFormat, VK_IMAGE_ASPECT_COLOR_BIT, mipLevels);
 	}
 
 	VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags, uint32_t mipLevels)
@@ -1614,8 +1732,6 @@ private:
 					1.0f - attrib.texcoords[2 * index.texcoord_index + 1]
 				};
 
-				vertex.color = { 1.0f, 1.0f, 1.0f };
-
 				if (uniqueVertices.count(vertex) == 0)
 				{
 					uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
@@ -1659,8 +1775,19 @@ private:
 
 	void createIndexBuffer()
 	{
+		const void* indexData	= indices.data();
+		VkDeviceSize bufferSize	= sizeof(indices[0]) * indices.size();
+
+		// 16-bit indices halve the buffer whenever the model is small enough
+		std::vector<uint16_t> shortIndices;
 
-		VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
+		if (vertices.size() < 65536)
+		{
+			shortIndices.assign(indices.begin(), indices.end());
+			indexData	= shortIndices.data();
+			bufferSize	= sizeof(shortIndices[0]) * shortIndices.size();
+			indexType	= VK_INDEX_TYPE_UINT16;
+		}
 
 		VkBuffer stagingBuffer;
 		VkDeviceMemory stagingBufferMemory;
@@ -1670,7 +1797,7 @@ private:
 
 		void* data;
 		vkMapMemory(device, stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, indices.data(), (size_t)bufferSize);
+		memcpy(data, indexData, (size_t)bufferSize);
 		vkUnmapMemory(device, stagingBufferMemory);
 
 		createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,